@@ -14,7 +14,7 @@
 #include <cfloat>      
 
 BSplineTrack::BSplineTrack(bool isLoop)
-    : degree(3), selectedPointIndex(-1), loop(isLoop), activeEditingCurve(CurveSide::Left), selectedCurve(CurveSide::None) {
+    : degree(3), selectedPointIndex(-1), loop(isLoop), activeEditingCurve(CurveSide::Left), selectedCurve(CurveSide::None), revision(0) {
     if (loop) { // desenha curvas iniciais
         // parte interna
         controlPointsLeft.push_back(Vector2(385, 372));  
@@ -64,6 +64,7 @@ BSplineTrack::BSplineTrack(bool isLoop)
 void BSplineTrack::switchActiveEditingCurve() {
     activeEditingCurve = (activeEditingCurve == CurveSide::Left) ? CurveSide::Right : CurveSide::Left;
     deselectControlPoint(); 
+    revision++;
 }
 
 // adiciona um ponto de controle na curva selecionada
@@ -80,6 +81,7 @@ void BSplineTrack::addControlPoint(const Vector2& p, int index) {
     } else {
         points.insert(points.begin() + index, p);
     }
+    revision++;
 }
 
 // remove o ultimo ponto de controle da curva selecionada
@@ -108,6 +110,7 @@ bool BSplineTrack::removeControlPoint(int index) {
 
     if (removalIdx >= 0 && removalIdx < (int)points.size()) {
         points.erase(points.begin() + removalIdx);
+        revision++;
 
         if (selectedCurve == activeEditingCurve) {
             if (selectedPointIndex == removalIdx) {
@@ -122,20 +125,23 @@ bool BSplineTrack::removeControlPoint(int index) {
 }
 
 // seleciona o ponto de controle que o mouse clicou
-bool BSplineTrack::selectControlPoint(float mx, float my) {
+bool BSplineTrack::selectControlPoint(float mx, float my, float radiusScale) {
     deselectControlPoint(); 
+    float selectRadiusSq = CONTROL_POINT_SELECT_RADIUS_SQ * radiusScale * radiusScale;
 
     for (size_t i = 0; i < controlPointsLeft.size(); ++i) {
-        if (controlPointsLeft[i].distSq(Vector2(mx, my)) < CONTROL_POINT_SELECT_RADIUS_SQ) {
+        if (controlPointsLeft[i].distSq(Vector2(mx, my)) < selectRadiusSq) {
             selectedPointIndex = i;
             selectedCurve = CurveSide::Left;
+            revision++;
             return true;
         }
     }
     for (size_t i = 0; i < controlPointsRight.size(); ++i) {
-        if (controlPointsRight[i].distSq(Vector2(mx, my)) < CONTROL_POINT_SELECT_RADIUS_SQ) {
+        if (controlPointsRight[i].distSq(Vector2(mx, my)) < selectRadiusSq) {
             selectedPointIndex = i;
             selectedCurve = CurveSide::Right;
+            revision++;
             return true;
         }
     }
@@ -148,13 +154,18 @@ void BSplineTrack::moveSelectedControlPoint(float mx, float my) {
 
     if (selectedCurve == CurveSide::Left && selectedPointIndex >= 0 && selectedPointIndex < (int)controlPointsLeft.size()) {
         controlPointsLeft[selectedPointIndex].set(mx, my);
+        revision++;
     } else if (selectedCurve == CurveSide::Right && selectedPointIndex >=0 && selectedPointIndex < (int)controlPointsRight.size()) {
         controlPointsRight[selectedPointIndex].set(mx, my);
+        revision++;
     }
 }
 
 // deseleciona o ponto de controle
 void BSplineTrack::deselectControlPoint() {
+    if (selectedPointIndex != -1 || selectedCurve != CurveSide::None) {
+        revision++;
+    }
     selectedPointIndex = -1;
     selectedCurve = CurveSide::None;
 }
@@ -260,17 +271,70 @@ Vector2 BSplineTrack::getTangentOnCurve(float t_global, CurveSide side) const {
     return Vector2(1,0); // não deve acontecer
 }
 
-// função auxiliar para renderizar uma única curva B-Spline
-void BSplineTrack::renderCurve(const std::vector<Vector2>& points, float r, float g, float b) const {
+// reconstrói as amostras da pista apenas quando ela foi editada ou a densidade mudou
+const TrackGeometry& BSplineTrack::GetGeometry(float detail) const {
+    const int fill_steps = std::max(20, static_cast<int>(100 * detail)); // mais segmentos para preenchimento mais suave
+    const int steps_per_segment = std::max(4, static_cast<int>(20 * detail)); // densidade de segmentos de linha para desenhar a curva
+
+    if (geometry.valid && geometry.revision == revision &&
+        geometry.fillSteps == fill_steps && geometry.stepsPerSegment == steps_per_segment) {
+        return geometry;
+    }
+
+    geometry.revision = revision;
+    geometry.fillSteps = fill_steps;
+    geometry.stepsPerSegment = steps_per_segment;
+    geometry.valid = true;
+    geometry.left.clear();
+    geometry.right.clear();
+    geometry.chunks.clear();
+
+    if (controlPointsLeft.size() >= MIN_CONTROL_POINTS_PER_CURVE &&
+        controlPointsRight.size() >= MIN_CONTROL_POINTS_PER_CURVE) {
+        for (int i = 0; i <= fill_steps; ++i) {
+            float t = static_cast<float>(i) / fill_steps;
+            geometry.left.push_back(getPointOnCurve(t, CurveSide::Left));
+            geometry.right.push_back(getPointOnCurve(t, CurveSide::Right));
+        }
+
+        // agrupa as amostras em trechos com caixa envolvente para o culling
+        const int STEPS_PER_CHUNK = 10;
+        for (int first = 0; first < fill_steps; first += STEPS_PER_CHUNK) {
+            TrackChunk chunk;
+            chunk.firstStep = first;
+            chunk.lastStep = std::min(first + STEPS_PER_CHUNK, fill_steps);
+            chunk.boundsMin = chunk.boundsMax = geometry.left[first];
+            for (int i = chunk.firstStep; i <= chunk.lastStep; ++i) {
+                expandBounds(chunk, geometry.left[i]);
+                expandBounds(chunk, geometry.right[i]);
+            }
+            geometry.chunks.push_back(chunk);
+        }
+    }
+
+    buildOutline(controlPointsLeft, steps_per_segment, geometry.outlineLeft, geometry.outlineChunksLeft);
+    buildOutline(controlPointsRight, steps_per_segment, geometry.outlineRight, geometry.outlineChunksRight);
+    return geometry;
+}
+
+void BSplineTrack::expandBounds(TrackChunk& chunk, const Vector2& p) {
+    chunk.boundsMin.x = std::min(chunk.boundsMin.x, p.x);
+    chunk.boundsMin.y = std::min(chunk.boundsMin.y, p.y);
+    chunk.boundsMax.x = std::max(chunk.boundsMax.x, p.x);
+    chunk.boundsMax.y = std::max(chunk.boundsMax.y, p.y);
+}
+
+// amostra uma borda como polilinha, com uma caixa envolvente por segmento B-Spline
+void BSplineTrack::buildOutline(const std::vector<Vector2>& points, int steps_per_segment,
+                                std::vector<Vector2>& outline, std::vector<TrackChunk>& chunks) const {
+    outline.clear();
+    chunks.clear();
     if (points.size() < MIN_CONTROL_POINTS_PER_CURVE) return;
 
     int num_control_points = points.size();
     int num_render_segments = loop ? num_control_points : num_control_points - degree;
     if (num_render_segments <= 0) return;
 
-    const int steps_per_segment = 20; // densidade de segmentos de linha para desenhar a curva
-    Vector2 last_pt;
-
     for (int i = 0; i < num_render_segments; ++i) { // itera por cada segmento B-Spline
         Vector2 cp0, cp1, cp2, cp3;
         if (loop) {
@@ -282,56 +346,67 @@ void BSplineTrack::renderCurve(const std::vector<Vector2>& points, float r, floa
             cp0 = points[i]; cp1 = points[i+1]; cp2 = points[i+2]; cp3 = points[i+3];
         }
 
-        for (int j = 0; j <= steps_per_segment; ++j) { // itera t_local de 0 a 1 para este segmento
+        TrackChunk chunk;
+        chunk.firstStep = static_cast<int>(outline.size()) - (i > 0 ? 1 : 0); // compartilha o ponto com o segmento anterior
+
+        for (int j = (i > 0 ? 1 : 0); j <= steps_per_segment; ++j) { // itera t_local de 0 a 1 para este segmento
             float t_local_in_segment = static_cast<float>(j) / steps_per_segment;
-            Vector2 current_pt = calculateBSplinePoint(t_local_in_segment, cp0, cp1, cp2, cp3);
+            outline.push_back(calculateBSplinePoint(t_local_in_segment, cp0, cp1, cp2, cp3));
+        }
 
-            if (j > 0 || i > 0) { // desenha linha se não for o primeiro ponto calculado
-                CV::color(r, g, b);
-                CV::line(last_pt.x, last_pt.y, current_pt.x, current_pt.y);
-            }
-            last_pt = current_pt;
+        chunk.lastStep = static_cast<int>(outline.size()) - 1;
+        chunk.boundsMin = chunk.boundsMax = outline[chunk.firstStep];
+        for (int k = chunk.firstStep; k <= chunk.lastStep; ++k) {
+            expandBounds(chunk, outline[k]);
         }
+        chunks.push_back(chunk);
     }
-    
-    if (loop && points.size() >= MIN_CONTROL_POINTS_PER_CURVE) {
-         Vector2 first_point_of_curve = getPointOnCurveInternal(0.0f, points);
-         CV::color(r, g, b);
-         CV::line(last_pt.x, last_pt.y, first_point_of_curve.x, first_point_of_curve.y);
+}
+
+// desenha os trechos visíveis de uma borda da pista
+void BSplineTrack::renderOutline(const std::vector<Vector2>& outline, const std::vector<TrackChunk>& chunks,
+                                 float r, float g, float b, const Camera* view) const {
+    CV::color(r, g, b);
+    for (const TrackChunk& chunk : chunks) {
+        if (view && !view->IsBoxVisible(chunk.boundsMin, chunk.boundsMax)) continue;
+
+        for (int k = chunk.firstStep; k < chunk.lastStep; ++k) {
+            CV::line(outline[k].x, outline[k].y, outline[k + 1].x, outline[k + 1].y);
+        }
     }
 }
 
 // renderiza a pista
-void BSplineTrack::Render(bool editorMode) {
+void BSplineTrack::Render(bool editorMode, float detail, const Camera* view) const {
+    const TrackGeometry& geo = GetGeometry(detail);
+
     // preenche a superfície da pista com uma cor sólida primeiro (novo código)
-    if (controlPointsLeft.size() >= MIN_CONTROL_POINTS_PER_CURVE && 
-        controlPointsRight.size() >= MIN_CONTROL_POINTS_PER_CURVE) {
-        
+    if (!geo.chunks.empty()) {
         // cor da superfície da estrada/pista - mudada para cinza claro (antiga cor de fundo)
         CV::color(0.5f, 0.5f, 0.5f);
         
-        const int fill_steps = 100; // mais segmentos para preenchimento mais suave
-        
-        // desenha triângulos preenchidos entre as curvas para criar uma superfície sólida
-        for (int i = 0; i < fill_steps; ++i) {
-            float t1 = static_cast<float>(i) / fill_steps;
-            float t2 = static_cast<float>(i+1) / fill_steps;
-            
-            Vector2 left1 = getPointOnCurve(t1, CurveSide::Left);
-            Vector2 right1 = getPointOnCurve(t1, CurveSide::Right);
-            Vector2 left2 = getPointOnCurve(t2, CurveSide::Left);
-            Vector2 right2 = getPointOnCurve(t2, CurveSide::Right);
-            
-            // desenha dois triângulos para formar um quadrilátero entre as curvas
-            // triângulo 1: left1, right1, left2
-            float vx1[3] = {left1.x, right1.x, left2.x};
-            float vy1[3] = {left1.y, right1.y, left2.y};
-            CV::triangleFill(vx1, vy1);
-            
-            // triângulo 2: left2, right1, right2
-            float vx2[3] = {left2.x, right1.x, right2.x};
-            float vy2[3] = {left2.y, right1.y, right2.y};
-            CV::triangleFill(vx2, vy2);
+        // desenha triângulos preenchidos entre as curvas para criar uma superfície sólida,
+        // apenas nos trechos que aparecem na tela
+        for (const TrackChunk& chunk : geo.chunks) {
+            if (view && !view->IsBoxVisible(chunk.boundsMin, chunk.boundsMax)) continue;
+
+            for (int i = chunk.firstStep; i < chunk.lastStep; ++i) {
+                const Vector2& left1 = geo.left[i];
+                const Vector2& right1 = geo.right[i];
+                const Vector2& left2 = geo.left[i + 1];
+                const Vector2& right2 = geo.right[i + 1];
+                
+                // desenha dois triângulos para formar um quadrilátero entre as curvas
+                // triângulo 1: left1, right1, left2
+                float vx1[3] = {left1.x, right1.x, left2.x};
+                float vy1[3] = {left1.y, right1.y, left2.y};
+                CV::triangleFill(vx1, vy1);
+                
+                // triângulo 2: left2, right1, right2
+                float vx2[3] = {left2.x, right1.x, right2.x};
+                float vy2[3] = {left2.y, right1.y, right2.y};
+                CV::triangleFill(vx2, vy2);
+            }
         }
         
         // adiciona uma linha pontilhada amarela no centro da pista
@@ -341,21 +416,15 @@ void BSplineTrack::Render(bool editorMode) {
         const int space_length = 2; // reduzido de 10 para 5 (traços mais frequentes)
         
         // calcula e desenha os traços da linha central
-        for (int i = 0; i < fill_steps; i += (dash_length + space_length)) {
-            // para cada traço
-            for (int j = i; j < i + dash_length && j < fill_steps; j++) {
-                float t1 = static_cast<float>(j) / fill_steps;
-                float t2 = static_cast<float>(j + 1) / fill_steps;
-                
-                // obtém pontos em ambas as curvas
-                Vector2 left1 = getPointOnCurve(t1, CurveSide::Left);
-                Vector2 right1 = getPointOnCurve(t1, CurveSide::Right);
-                Vector2 left2 = getPointOnCurve(t2, CurveSide::Left);
-                Vector2 right2 = getPointOnCurve(t2, CurveSide::Right);
-                
+        for (const TrackChunk& chunk : geo.chunks) {
+            if (view && !view->IsBoxVisible(chunk.boundsMin, chunk.boundsMax)) continue;
+
+            for (int j = chunk.firstStep; j < chunk.lastStep; j++) {
+                if (j % (dash_length + space_length) >= dash_length) continue; // espaço entre traços
+
                 // calcula pontos centrais
-                Vector2 center1((left1.x + right1.x) * 0.5f, (left1.y + right1.y) * 0.5f);
-                Vector2 center2((left2.x + right2.x) * 0.5f, (left2.y + right2.y) * 0.5f);
+                Vector2 center1((geo.left[j].x + geo.right[j].x) * 0.5f, (geo.left[j].y + geo.right[j].y) * 0.5f);
+                Vector2 center2((geo.left[j + 1].x + geo.right[j + 1].x) * 0.5f, (geo.left[j + 1].y + geo.right[j + 1].y) * 0.5f);
                 
                 // desenha segmento de linha para esta parte do traço
                 CV::line(center1.x, center1.y, center2.x, center2.y);
@@ -364,67 +433,75 @@ void BSplineTrack::Render(bool editorMode) {
     }
     
     // renderiza o limite da curva à esquerda (por exemplo, limite verde)
-    renderCurve(controlPointsLeft, 0.1f, 0.1f, 0.4f); // verde mais escuro para a linha em si
+    renderOutline(geo.outlineLeft, geo.outlineChunksLeft, 0.1f, 0.1f, 0.4f, view); // verde mais escuro para a linha em si
     
     // renderiza o limite da curva à direita (por exemplo, limite vermelho)
-    renderCurve(controlPointsRight, 0.1f, 0.1f, 0.4f); // vermelho mais escuro para a linha em si
+    renderOutline(geo.outlineRight, geo.outlineChunksRight, 0.1f, 0.1f, 0.4f, view); // vermelho mais escuro para a linha em si
 
     // desenha pontos de controle se estiver no modo editor
     if (editorMode) {
-        char pointLabel[10];
-
-        // desenha pontos de controle à esquerda
-        for (size_t i = 0; i < controlPointsLeft.size(); ++i) {
-            bool isSelected = (selectedPointIndex == static_cast<int>(i) && selectedCurve == CurveSide::Left);
-            bool isActiveEditing = (activeEditingCurve == CurveSide::Left);
-
-            if (isSelected) CV::color(1.0f, 0.65f, 0.0f); // laranja para selecionado
-            else if (isActiveEditing) CV::color(0.0f, 1.0f, 0.0f); // verde brilhante para curva de edição ativa
-            else CV::color(0.0f, 0.5f, 0.0f); // verde mais escuro para inativo
-            
-            CV::circleFill(controlPointsLeft[i].x, controlPointsLeft[i].y, CONTROL_POINT_DRAW_RADIUS, 10);
-            sprintf(pointLabel, "L%zu", i);
-            CV::color(1,1,1); // texto branco
-            CV::text(controlPointsLeft[i].x + CONTROL_POINT_DRAW_RADIUS + 3, controlPointsLeft[i].y - CONTROL_POINT_DRAW_RADIUS - 12, pointLabel);
-        }
+        RenderControlPoints();
+    }
+}
 
-        // desenha pontos de controle à direita
-        for (size_t i = 0; i < controlPointsRight.size(); ++i) {
-            bool isSelected = (selectedPointIndex == static_cast<int>(i) && selectedCurve == CurveSide::Right);
-            bool isActiveEditing = (activeEditingCurve == CurveSide::Right);
+// pontos de controle e seus rótulos (modo editor)
+void BSplineTrack::RenderControlPoints() const {
+    char pointLabel[10];
 
-            if (isSelected) CV::color(1.0f, 0.65f, 0.0f); // laranja para selecionado
-            else if (isActiveEditing) CV::color(1.0f, 0.0f, 0.0f); // vermelho brilhante para curva de edição ativa
-            else CV::color(0.5f, 0.0f, 0.0f); // vermelho mais escuro para inativo
+    // desenha pontos de controle à esquerda
+    for (size_t i = 0; i < controlPointsLeft.size(); ++i) {
+        bool isSelected = (selectedPointIndex == static_cast<int>(i) && selectedCurve == CurveSide::Left);
+        bool isActiveEditing = (activeEditingCurve == CurveSide::Left);
 
-            CV::circleFill(controlPointsRight[i].x, controlPointsRight[i].y, CONTROL_POINT_DRAW_RADIUS, 10);
-            sprintf(pointLabel, "R%zu", i);
-            CV::color(1,1,1); // texto branco
-            CV::text(controlPointsRight[i].x + CONTROL_POINT_DRAW_RADIUS + 3, controlPointsRight[i].y - CONTROL_POINT_DRAW_RADIUS - 12, pointLabel);
-        }
-        
-        // texto de ajuda do modo editor
-        CV::color(1,1,1);
-        std::string activeCurveStr = (activeEditingCurve == CurveSide::Left) ? "LEFT (Verde)" : "RIGHT (Vermelho)";
-        std::string selectedInfoStr = "Nenhum";
-        if (selectedCurve != CurveSide::None && selectedPointIndex != -1) {
-            selectedInfoStr = (selectedCurve == CurveSide::Left ? "L" : "R") + std::to_string(selectedPointIndex);
-        }
+        if (isSelected) CV::color(1.0f, 0.65f, 0.0f); // laranja para selecionado
+        else if (isActiveEditing) CV::color(0.0f, 1.0f, 0.0f); // verde brilhante para curva de edição ativa
+        else CV::color(0.0f, 0.5f, 0.0f); // verde mais escuro para inativo
         
-        char editorHelpTextLine1[200];
-        char editorHelpTextLine2[200];
-        char editorHelpTextLine3[200];
-        char editorHelpTextLine4[200];
-        sprintf(editorHelpTextLine1, "Modo de Edicao | Curva Selecionada: %s", 
-                activeCurveStr.c_str(), selectedInfoStr.c_str());
-        sprintf(editorHelpTextLine2, "'A' = Add (adiciona ponto de controle para a curva selecionada)");
-        sprintf(editorHelpTextLine3, "'D' = Delete (deleta um ponto de controle da curva)");
-        sprintf(editorHelpTextLine4, "'S' = Switch (troca entre pontos das curvas esquerda e direita)");
-        CV::text(10, 20, editorHelpTextLine1);
-        CV::text(10, 40, editorHelpTextLine2);
-        CV::text(10, 60, editorHelpTextLine3);
-        CV::text(10, 80, editorHelpTextLine4);
+        CV::circleFill(controlPointsLeft[i].x, controlPointsLeft[i].y, CONTROL_POINT_DRAW_RADIUS, 10);
+        sprintf(pointLabel, "L%zu", i);
+        CV::color(1,1,1); // texto branco
+        CV::text(controlPointsLeft[i].x + CONTROL_POINT_DRAW_RADIUS + 3, controlPointsLeft[i].y - CONTROL_POINT_DRAW_RADIUS - 12, pointLabel);
+    }
+
+    // desenha pontos de controle à direita
+    for (size_t i = 0; i < controlPointsRight.size(); ++i) {
+        bool isSelected = (selectedPointIndex == static_cast<int>(i) && selectedCurve == CurveSide::Right);
+        bool isActiveEditing = (activeEditingCurve == CurveSide::Right);
+
+        if (isSelected) CV::color(1.0f, 0.65f, 0.0f); // laranja para selecionado
+        else if (isActiveEditing) CV::color(1.0f, 0.0f, 0.0f); // vermelho brilhante para curva de edição ativa
+        else CV::color(0.5f, 0.0f, 0.0f); // vermelho mais escuro para inativo
+
+        CV::circleFill(controlPointsRight[i].x, controlPointsRight[i].y, CONTROL_POINT_DRAW_RADIUS, 10);
+        sprintf(pointLabel, "R%zu", i);
+        CV::color(1,1,1); // texto branco
+        CV::text(controlPointsRight[i].x + CONTROL_POINT_DRAW_RADIUS + 3, controlPointsRight[i].y - CONTROL_POINT_DRAW_RADIUS - 12, pointLabel);
+    }
+}
+
+// texto de ajuda do modo editor, desenhado em coordenadas de tela
+void BSplineTrack::RenderEditorHelp() const {
+    CV::color(1,1,1);
+    std::string activeCurveStr = (activeEditingCurve == CurveSide::Left) ? "LEFT (Verde)" : "RIGHT (Vermelho)";
+    std::string selectedInfoStr = "Nenhum";
+    if (selectedCurve != CurveSide::None && selectedPointIndex != -1) {
+        selectedInfoStr = (selectedCurve == CurveSide::Left ? "L" : "R") + std::to_string(selectedPointIndex);
     }
+    
+    char editorHelpTextLine1[200];
+    char editorHelpTextLine2[200];
+    char editorHelpTextLine3[200];
+    char editorHelpTextLine4[200];
+    sprintf(editorHelpTextLine1, "Modo de Edicao | Curva Selecionada: %s", 
+            activeCurveStr.c_str(), selectedInfoStr.c_str());
+    sprintf(editorHelpTextLine2, "'A' = Add (adiciona ponto de controle para a curva selecionada)");
+    sprintf(editorHelpTextLine3, "'D' = Delete (deleta um ponto de controle da curva)");
+    sprintf(editorHelpTextLine4, "'S' = Switch (troca entre pontos das curvas esquerda e direita)");
+    CV::text(10, 20, editorHelpTextLine1);
+    CV::text(10, 40, editorHelpTextLine2);
+    CV::text(10, 60, editorHelpTextLine3);
+    CV::text(10, 80, editorHelpTextLine4);
+    CV::text(10, 100, "Setas/M2 arrastando = Mover camera | Roda do mouse = Zoom");
 }
 
 // encontra o ponto mais próximo na curva especificada para um ponto de consulta
@@ -507,3 +584,351 @@ ClosestPointInfo BSplineTrack::findClosestPointOnCurve(const Vector2& queryPoint
     }
     return closestInfo;
 }
+
+// primeiro instante t em [0, tMax] em que o ponto from + delta * t fica a radius do segmento ab
+// (ponto contra cápsula). retorna false se não encosta antes de tMax
+static bool sweepPointCapsule(const Vector2& from, const Vector2& delta, float radius,
+                              const Vector2& a, const Vector2& b, float tMax,
+                              float& time, Vector2& contactPoint) {
+    float ex = b.x - a.x, ey = b.y - a.y;
+    float lenSq = ex * ex + ey * ey;
+
+    // já começa encostando: só conta se estiver se aproximando do segmento
+    float s0 = lenSq > 1e-8f ? ((from.x - a.x) * ex + (from.y - a.y) * ey) / lenSq : 0.0f;
+    s0 = std::max(0.0f, std::min(1.0f, s0));
+    float qx = a.x + ex * s0, qy = a.y + ey * s0;
+    float mx = from.x - qx, my = from.y - qy;
+    if (mx * mx + my * my <= radius * radius) {
+        if (mx * delta.x + my * delta.y >= 0.0f) return false;
+        time = 0.0f;
+        contactPoint.set(qx, qy);
+        return true;
+    }
+
+    bool found = false;
+
+    // lados retos da cápsula
+    if (lenSq > 1e-8f) {
+        float len = std::sqrt(lenSq);
+        float nx = -ey / len, ny = ex / len;
+        float dist0 = (from.x - a.x) * nx + (from.y - a.y) * ny;
+        float speed = delta.x * nx + delta.y * ny;
+        float sign = dist0 >= 0.0f ? 1.0f : -1.0f;
+        if (sign * dist0 > radius && sign * speed < 0.0f) {
+            float t = (sign * dist0 - radius) / (-sign * speed);
+            if (t <= tMax) {
+                float px = from.x + delta.x * t - a.x;
+                float py = from.y + delta.y * t - a.y;
+                float s = (px * ex + py * ey) / lenSq;
+                if (s >= 0.0f && s <= 1.0f) {
+                    tMax = time = t;
+                    contactPoint.set(a.x + ex * s, a.y + ey * s);
+                    found = true;
+                }
+            }
+        }
+    }
+
+    // pontas arredondadas
+    const Vector2* ends[2] = { &a, &b };
+    float deltaSq = delta.x * delta.x + delta.y * delta.y;
+    if (deltaSq > 1e-12f) {
+        for (int e = 0; e < 2; ++e) {
+            float cx = from.x - ends[e]->x, cy = from.y - ends[e]->y;
+            float half_b = cx * delta.x + cy * delta.y;
+            float c = cx * cx + cy * cy - radius * radius;
+            if (half_b >= 0.0f) continue;
+            float disc = half_b * half_b - deltaSq * c;
+            if (disc < 0.0f) continue;
+            float t = (-half_b - std::sqrt(disc)) / deltaSq;
+            if (t >= 0.0f && t <= tMax) {
+                tMax = time = t;
+                contactPoint = *ends[e];
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+bool BSplineTrack::sweepCircle(const Vector2& from, const Vector2& to, float radius, SweepHit& hit) const {
+    const TrackGeometry& geo = GetGeometry();
+    Vector2 delta(to.x - from.x, to.y - from.y);
+
+    // caixa do movimento inteiro, usada para descartar trechos da borda
+    Vector2 sweepMin(std::min(from.x, to.x) - radius, std::min(from.y, to.y) - radius);
+    Vector2 sweepMax(std::max(from.x, to.x) + radius, std::max(from.y, to.y) + radius);
+
+    const std::vector<Vector2>* outlines[2] = { &geo.outlineLeft, &geo.outlineRight };
+    const std::vector<TrackChunk>* chunkLists[2] = { &geo.outlineChunksLeft, &geo.outlineChunksRight };
+
+    bool found = false;
+    float bestTime = 1.0f;
+    for (int side = 0; side < 2; ++side) {
+        const std::vector<Vector2>& outline = *outlines[side];
+        const std::vector<TrackChunk>& chunks = *chunkLists[side];
+
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            const TrackChunk& chunk = chunks[c];
+            if (chunk.boundsMax.x < sweepMin.x || chunk.boundsMin.x > sweepMax.x ||
+                chunk.boundsMax.y < sweepMin.y || chunk.boundsMin.y > sweepMax.y) continue;
+
+            for (int k = chunk.firstStep; k < chunk.lastStep; ++k) {
+                float time;
+                Vector2 contactPoint;
+                if (sweepPointCapsule(from, delta, radius, outline[k], outline[k + 1], bestTime, time, contactPoint)) {
+                    bestTime = time;
+                    hit.time = time;
+                    hit.point = contactPoint;
+                    hit.side = static_cast<CurveSide>(side);
+                    found = true;
+                }
+            }
+        }
+    }
+
+    if (found) {
+        // normal do ponto tocado para o centro do círculo no instante do contato
+        hit.normal.set(from.x + delta.x * hit.time - hit.point.x, from.y + delta.y * hit.time - hit.point.y);
+        if (hit.normal.lengthSq() > 1e-12f) {
+            hit.normal.normalize();
+        } else {
+            hit.normal.set(-delta.x, -delta.y);
+            hit.normal.normalize();
+        }
+    }
+    return found;
+}
+
+void BSplineTrack::updateSegmentWindow(const Vector2& center, float reach, SegmentWindow& window) const {
+    const TrackGeometry& geo = GetGeometry();
+
+    // a janela ainda cobre tudo que está a reach do centro
+    if (window.valid && window.revision == revision && reach <= window.reach) {
+        float dx = center.x - window.center.x;
+        float dy = center.y - window.center.y;
+        if (dx * dx + dy * dy <= SegmentWindow::MARGIN * SegmentWindow::MARGIN) return;
+    }
+
+    window.center = center;
+    window.reach = reach;
+    window.revision = revision;
+    window.valid = true;
+
+    float gather = reach + SegmentWindow::MARGIN;
+    Vector2 gatherMin(center.x - gather, center.y - gather);
+    Vector2 gatherMax(center.x + gather, center.y + gather);
+
+    const std::vector<Vector2>* outlines[2] = { &geo.outlineLeft, &geo.outlineRight };
+    const std::vector<TrackChunk>* chunkLists[2] = { &geo.outlineChunksLeft, &geo.outlineChunksRight };
+
+    for (int side = 0; side < 2; ++side) {
+        const std::vector<Vector2>& outline = *outlines[side];
+        const std::vector<TrackChunk>& chunks = *chunkLists[side];
+        window.count[side] = 0;
+
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            const TrackChunk& chunk = chunks[c];
+            if (chunk.boundsMax.x < gatherMin.x || chunk.boundsMin.x > gatherMax.x ||
+                chunk.boundsMax.y < gatherMin.y || chunk.boundsMin.y > gatherMax.y) continue;
+
+            for (int k = chunk.firstStep; k < chunk.lastStep; ++k) {
+                const Vector2& a = outline[k];
+                const Vector2& b = outline[k + 1];
+                if (std::max(a.x, b.x) < gatherMin.x || std::min(a.x, b.x) > gatherMax.x ||
+                    std::max(a.y, b.y) < gatherMin.y || std::min(a.y, b.y) > gatherMax.y) continue;
+
+                if (window.count[side] == SegmentWindow::MAX_SEGMENTS) {
+                    // pista muito densa para a janela: vale só para este passo
+                    window.valid = false;
+                    break;
+                }
+                window.segments[side][window.count[side]++] = k;
+            }
+        }
+    }
+}
+
+// sobreposição das projeções da caixa e do segmento no eixo (ax, ay); <= 0 separa
+static float boxSegmentOverlap(float ax, float ay, const Vector2& center, float ux, float uy, float halfW, float halfH,
+                               const Vector2& a, const Vector2& b, float& segmentMid, float& boxMid) {
+    boxMid = center.x * ax + center.y * ay;
+    float boxExtent = halfW * std::fabs(ux * ax + uy * ay) + halfH * std::fabs(-uy * ax + ux * ay);
+    float pa = a.x * ax + a.y * ay;
+    float pb = b.x * ax + b.y * ay;
+    segmentMid = (pa + pb) * 0.5f;
+    return std::min(boxMid + boxExtent - std::min(pa, pb), std::max(pa, pb) - (boxMid - boxExtent));
+}
+
+bool BSplineTrack::collideBox(const Vector2& center, float halfW, float halfH, float angle,
+                              SegmentWindow& window, BoxContact& contact) const {
+    updateSegmentWindow(center, std::sqrt(halfW * halfW + halfH * halfH), window);
+
+    const TrackGeometry& geo = GetGeometry();
+    const std::vector<Vector2>* outlines[2] = { &geo.outlineLeft, &geo.outlineRight };
+
+    float ux = std::cos(angle), uy = std::sin(angle);
+    bool found = false;
+
+    for (int side = 0; side < 2; ++side) {
+        const std::vector<Vector2>& outline = *outlines[side];
+        for (int w = 0; w < window.count[side]; ++w) {
+            const Vector2& a = outline[window.segments[side][w]];
+            const Vector2& b = outline[window.segments[side][w] + 1];
+
+            float ex = b.x - a.x, ey = b.y - a.y;
+            float len = std::sqrt(ex * ex + ey * ey);
+            if (len < 1e-6f) continue;
+
+            // eixos candidatos: os dois lados da caixa e a normal do segmento
+            float axes[3][2] = { { ux, uy }, { -uy, ux }, { -ey / len, ex / len } };
+            float minOverlap = FLT_MAX;
+            float normalX = 0.0f, normalY = 0.0f;
+            bool separated = false;
+
+            for (int i = 0; i < 3; ++i) {
+                float segmentMid, boxMid;
+                float overlap = boxSegmentOverlap(axes[i][0], axes[i][1], center, ux, uy, halfW, halfH,
+                                                  a, b, segmentMid, boxMid);
+                if (overlap <= 0.0f) { separated = true; break; }
+                if (overlap < minOverlap) {
+                    // a normal aponta do segmento para a caixa
+                    float sign = boxMid >= segmentMid ? 1.0f : -1.0f;
+                    minOverlap = overlap;
+                    normalX = axes[i][0] * sign;
+                    normalY = axes[i][1] * sign;
+                }
+            }
+            if (separated) continue;
+
+            if (!found || minOverlap > contact.depth) {
+                contact.depth = minOverlap;
+                contact.normal.set(normalX, normalY);
+                contact.side = static_cast<CurveSide>(side);
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+void BSplineTrack::rayCast(RayQuery* queries, int count) const {
+    const TrackGeometry& geo = GetGeometry();
+    for (int q = 0; q < count; ++q) {
+        queries[q].time = 1.0f;
+        queries[q].hit = false;
+    }
+
+    const std::vector<Vector2>* outlines[2] = { &geo.outlineLeft, &geo.outlineRight };
+    const std::vector<TrackChunk>* chunkLists[2] = { &geo.outlineChunksLeft, &geo.outlineChunksRight };
+
+    for (int side = 0; side < 2; ++side) {
+        const std::vector<Vector2>& outline = *outlines[side];
+        const std::vector<TrackChunk>& chunks = *chunkLists[side];
+
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            const TrackChunk& chunk = chunks[c];
+
+            for (int q = 0; q < count; ++q) {
+                RayQuery& query = queries[q];
+                float dx = query.to.x - query.from.x;
+                float dy = query.to.y - query.from.y;
+
+                // só a parte do raio antes do melhor contato até agora
+                float endX = query.from.x + dx * query.time;
+                float endY = query.from.y + dy * query.time;
+                if (chunk.boundsMax.x < std::min(query.from.x, endX) || chunk.boundsMin.x > std::max(query.from.x, endX) ||
+                    chunk.boundsMax.y < std::min(query.from.y, endY) || chunk.boundsMin.y > std::max(query.from.y, endY)) continue;
+
+                for (int k = chunk.firstStep; k < chunk.lastStep; ++k) {
+                    const Vector2& a = outline[k];
+                    float ex = outline[k + 1].x - a.x;
+                    float ey = outline[k + 1].y - a.y;
+                    float denom = dx * ey - dy * ex;
+                    if (std::fabs(denom) < 1e-9f) continue; // paralelos
+
+                    float ax = a.x - query.from.x;
+                    float ay = a.y - query.from.y;
+                    float t = (ax * ey - ay * ex) / denom;   // ao longo do raio
+                    float s = (ax * dy - ay * dx) / denom;   // ao longo do segmento
+                    if (t >= 0.0f && t < query.time && s >= 0.0f && s <= 1.0f) {
+                        query.time = t;
+                        query.hit = true;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void BSplineTrack::buildClearanceGrid() const {
+    const TrackGeometry& geo = GetGeometry();
+    clearance.revision = revision;
+    clearance.valid = true;
+    clearance.cells.clear();
+    clearance.cols = clearance.rows = 0;
+
+    const std::vector<Vector2>* outlines[2] = { &geo.outlineLeft, &geo.outlineRight };
+    const std::vector<TrackChunk>* chunkLists[2] = { &geo.outlineChunksLeft, &geo.outlineChunksRight };
+
+    // a grade cobre as duas bordas com uma folga em volta
+    bool empty = true;
+    Vector2 boundsMin, boundsMax;
+    for (int side = 0; side < 2; ++side) {
+        const std::vector<TrackChunk>& chunks = *chunkLists[side];
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            if (empty) {
+                boundsMin = chunks[c].boundsMin;
+                boundsMax = chunks[c].boundsMax;
+                empty = false;
+            }
+            boundsMin.set(std::min(boundsMin.x, chunks[c].boundsMin.x), std::min(boundsMin.y, chunks[c].boundsMin.y));
+            boundsMax.set(std::max(boundsMax.x, chunks[c].boundsMax.x), std::max(boundsMax.y, chunks[c].boundsMax.y));
+        }
+    }
+    if (empty) return;
+
+    const float cell = ClearanceGrid::CELL_SIZE;
+    clearance.origin.set(boundsMin.x - ClearanceGrid::MARGIN, boundsMin.y - ClearanceGrid::MARGIN);
+    clearance.cols = static_cast<int>(std::ceil((boundsMax.x - boundsMin.x + 2.0f * ClearanceGrid::MARGIN) / cell));
+    clearance.rows = static_cast<int>(std::ceil((boundsMax.y - boundsMin.y + 2.0f * ClearanceGrid::MARGIN) / cell));
+    clearance.cells.assign(clearance.cols * clearance.rows, 0.0f);
+
+    // o centro da célula está a no máximo meia diagonal de qualquer ponto dela
+    const float halfDiagonal = 0.5f * cell * std::sqrt(2.0f);
+
+    for (int cy = 0; cy < clearance.rows; ++cy) {
+        for (int cx = 0; cx < clearance.cols; ++cx) {
+            float px = clearance.origin.x + (cx + 0.5f) * cell;
+            float py = clearance.origin.y + (cy + 0.5f) * cell;
+            float bestSq = FLT_MAX;
+
+            for (int side = 0; side < 2; ++side) {
+                const std::vector<Vector2>& outline = *outlines[side];
+                const std::vector<TrackChunk>& chunks = *chunkLists[side];
+
+                for (size_t c = 0; c < chunks.size(); ++c) {
+                    const TrackChunk& chunk = chunks[c];
+                    // trecho inteiro mais longe que o melhor segmento achado: pula
+                    float ox = std::max(0.0f, std::max(chunk.boundsMin.x - px, px - chunk.boundsMax.x));
+                    float oy = std::max(0.0f, std::max(chunk.boundsMin.y - py, py - chunk.boundsMax.y));
+                    if (ox * ox + oy * oy >= bestSq) continue;
+
+                    for (int k = chunk.firstStep; k < chunk.lastStep; ++k) {
+                        const Vector2& a = outline[k];
+                        const Vector2& b = outline[k + 1];
+                        float ex = b.x - a.x, ey = b.y - a.y;
+                        float lenSq = ex * ex + ey * ey;
+                        float t = lenSq > 1e-12f ? ((px - a.x) * ex + (py - a.y) * ey) / lenSq : 0.0f;
+                        t = std::max(0.0f, std::min(1.0f, t));
+                        float dx = a.x + ex * t - px;
+                        float dy = a.y + ey * t - py;
+                        bestSq = std::min(bestSq, dx * dx + dy * dy);
+                    }
+                }
+            }
+
+            clearance.cells[cy * clearance.cols + cx] = std::max(0.0f, std::sqrt(bestSq) - halfDiagonal);
+        }
+    }
+}
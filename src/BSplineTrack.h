@@ -11,6 +11,7 @@
 #include <vector>
 #include "Vector2.h" 
 #include "gl_canvas2d.h" 
+#include "Camera.h"
 #include <cmath>     
 #include <algorithm>  
 #include <cstdio>    
@@ -38,6 +39,96 @@ struct ClosestPointInfo {
     ClosestPointInfo() : point(), t_global(0.0f), distance(FLT_MAX), normal(), segmentIndex(-1), isValid(false) {}
 };
 
+// primeiro contato de um círculo em movimento com uma borda da pista
+struct SweepHit {
+    float time;       // fração do movimento (0 a 1) no instante do contato
+    Vector2 point;    // ponto da borda tocado
+    Vector2 normal;   // da borda para o centro do círculo
+    CurveSide side;
+
+    SweepHit() : time(1.0f), point(), normal(), side(CurveSide::None) {}
+};
+
+// consulta de raio contra as bordas; time e hit são preenchidos por rayCast
+struct RayQuery {
+    Vector2 from;
+    Vector2 to;
+    float time;    // fração de from até to onde bate na primeira parede (1 se não bateu)
+    bool hit;
+
+    RayQuery() : from(), to(), time(1.0f), hit(false) {}
+    RayQuery(const Vector2& a, const Vector2& b) : from(a), to(b), time(1.0f), hit(false) {}
+
+    Vector2 HitPoint() const { return Vector2(from.x + (to.x - from.x) * time, from.y + (to.y - from.y) * time); }
+};
+
+// segmentos das bordas perto de um objeto, guardados entre passos.
+// só é refeita quando o objeto sai da região coberta ou a pista muda
+struct SegmentWindow {
+    static const int MAX_SEGMENTS = 128;     // por borda
+    static constexpr float MARGIN = 48.0f;   // quanto o objeto pode andar antes de refazer
+
+    int segments[2][MAX_SEGMENTS];  // k do segmento (k, k + 1) na polilinha de cada borda
+    int count[2];
+    Vector2 center;
+    float reach;
+    unsigned int revision;
+    bool valid;
+
+    SegmentWindow() : center(), reach(0.0f), revision(0), valid(false) { count[0] = count[1] = 0; }
+};
+
+// penetração de uma caixa orientada numa borda
+struct BoxContact {
+    float depth;      // quanto a caixa entrou no segmento
+    Vector2 normal;   // direção para empurrar a caixa para fora
+    CurveSide side;
+
+    BoxContact() : depth(0.0f), normal(), side(CurveSide::None) {}
+};
+
+// trecho de amostras da pista e a caixa que o envolve, usado para o culling
+struct TrackChunk {
+    int firstStep;      // primeira amostra do trecho
+    int lastStep;       // última amostra do trecho (inclusive)
+    Vector2 boundsMin;
+    Vector2 boundsMax;
+};
+
+// geometria tesselada da pista, refeita apenas quando a pista ou a densidade mudam
+struct TrackGeometry {
+    std::vector<Vector2> left;   // amostras da borda esquerda no mesmo t da direita (preenchimento)
+    std::vector<Vector2> right;
+    std::vector<TrackChunk> chunks;
+
+    std::vector<Vector2> outlineLeft;  // polilinhas das bordas
+    std::vector<Vector2> outlineRight;
+    std::vector<TrackChunk> outlineChunksLeft;  // um trecho por segmento B-Spline
+    std::vector<TrackChunk> outlineChunksRight;
+
+    unsigned int revision;
+    int fillSteps;
+    int stepsPerSegment;
+    bool valid;
+
+    TrackGeometry() : revision(0), fillSteps(0), stepsPerSegment(0), valid(false) {}
+};
+
+// grade com a distância mínima de cada célula até as bordas, para descartar
+// de uma vez os objetos que não podem alcançar parede nenhuma neste passo
+struct ClearanceGrid {
+    static constexpr float CELL_SIZE = 32.0f;
+    static constexpr float MARGIN = 64.0f;   // folga em volta das bordas coberta pela grade
+
+    std::vector<float> cells;   // limite inferior da distância de qualquer ponto da célula a uma borda
+    Vector2 origin;
+    int cols, rows;
+    unsigned int revision;
+    bool valid;
+
+    ClearanceGrid() : origin(), cols(0), rows(0), revision(0), valid(false) {}
+};
+
 class BSplineTrack {
 public:
     std::vector<Vector2> controlPointsLeft;
@@ -49,6 +140,9 @@ public:
     CurveSide activeEditingCurve;
     CurveSide selectedCurve;
 
+    // incrementado a cada edição (pontos ou seleção), usado para saber quando copiar a pista
+    unsigned int revision;
+
     // constantes
     const int MIN_CONTROL_POINTS_PER_CURVE = 4; 
     const int MAX_CONTROL_POINTS = 20;
@@ -61,23 +155,72 @@ public:
     void addControlPoint(const Vector2& p, int index = -1);
     bool removeControlPoint(int index = -1);
 
-    bool selectControlPoint(float mx, float my);
+    // radiusScale ajusta o raio de seleção (ex: 1/zoom para manter o mesmo tamanho na tela)
+    bool selectControlPoint(float mx, float my, float radiusScale = 1.0f);
     void moveSelectedControlPoint(float mx, float my);
     void deselectControlPoint();
     void switchActiveEditingCurve();
 
-    void Render(bool editorMode);
+    // detail reduz a densidade de tesselação (1 = densidade original).
+    // com uma câmera, só os trechos visíveis são desenhados
+    void Render(bool editorMode, float detail = 1.0f, const Camera* view = nullptr) const;
+    void RenderControlPoints() const;
+    void RenderEditorHelp() const;
+
+    // amostras em cache da pista para a densidade pedida
+    const TrackGeometry& GetGeometry(float detail = 1.0f) const;
 
     Vector2 getPointOnCurve(float t_global, CurveSide side) const;
     Vector2 getTangentOnCurve(float t_global, CurveSide side) const; 
 
     ClosestPointInfo findClosestPointOnCurve(const Vector2& queryPoint, CurveSide side) const;
 
+    // círculo indo de from até to contra as polilinhas das duas bordas (densidade original).
+    // retorna o primeiro contato; se já começa encostando e se aproxima da borda, time = 0
+    bool sweepCircle(const Vector2& from, const Vector2& to, float radius, SweepHit& hit) const;
+
+    // vários raios de uma vez: cada trecho das bordas é lido uma vez só para todos os raios que passam por ele
+    void rayCast(RayQuery* queries, int count) const;
+    bool rayCast(RayQuery& query) const { rayCast(&query, 1); return query.hit; }
+
+    // caixa orientada (meias medidas halfW x halfH, girada de angle) contra os segmentos da janela,
+    // pelo teorema do eixo separador. retorna o contato mais profundo
+    bool collideBox(const Vector2& center, float halfW, float halfH, float angle,
+                    SegmentWindow& window, BoxContact& contact) const;
+
+    // distância garantida de p até a borda mais próxima (0 fora da grade ou sem pista).
+    // um círculo de raio r que anda menos que wallClearance(p) - r não encosta em nada
+    float wallClearance(const Vector2& p) const {
+        const ClearanceGrid& grid = GetClearanceGrid();
+        int cx = static_cast<int>(std::floor((p.x - grid.origin.x) / ClearanceGrid::CELL_SIZE));
+        int cy = static_cast<int>(std::floor((p.y - grid.origin.y) / ClearanceGrid::CELL_SIZE));
+        if (cx < 0 || cy < 0 || cx >= grid.cols || cy >= grid.rows) return 0.0f;
+        return grid.cells[cy * grid.cols + cx];
+    }
+
+    const ClearanceGrid& GetClearanceGrid() const {
+        if (!clearance.valid || clearance.revision != revision) buildClearanceGrid();
+        return clearance;
+    }
+
 private:
     Vector2 calculateBSplinePoint(float t, const Vector2& p0, const Vector2& p1, const Vector2& p2, const Vector2& p3) const;
     Vector2 calculateBSplineTangent(float t, const Vector2& p0, const Vector2& p1, const Vector2& p2, const Vector2& p3) const;
     
-    void renderCurve(const std::vector<Vector2>& points, float r_color, float g_color, float b_color) const;
+    void buildOutline(const std::vector<Vector2>& points, int steps_per_segment,
+                      std::vector<Vector2>& outline, std::vector<TrackChunk>& chunks) const;
+    void renderOutline(const std::vector<Vector2>& outline, const std::vector<TrackChunk>& chunks,
+                       float r_color, float g_color, float b_color, const Camera* view) const;
+    static void expandBounds(TrackChunk& chunk, const Vector2& p);
+
+    // junta em window os segmentos a até reach + MARGIN de center
+    void updateSegmentWindow(const Vector2& center, float reach, SegmentWindow& window) const;
+
+    // cache da tesselação (preenchido sob demanda pelas funções const de renderização)
+    mutable TrackGeometry geometry;
+    mutable ClearanceGrid clearance;
+
+    void buildClearanceGrid() const;
 
     Vector2 getPointOnCurveInternal(float t_global, const std::vector<Vector2>& points_list) const;
     Vector2 getTangentOnCurveInternal(float t_global, const std::vector<Vector2>& points_list) const;
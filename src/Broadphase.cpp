@@ -0,0 +1,110 @@
+/**
+ * Broadphase.cpp
+ * Implementa a grade uniforme com tabela hash e ordenação por contagem.
+ * O lado da célula é o dobro do maior raio do passo, então um par que se
+ * sobrepõe sempre está na mesma célula ou numa das 8 vizinhas.
+ */
+
+#include "Broadphase.h"
+#include <cmath>
+#include <algorithm>
+
+static const int MIN_TABLE_SIZE = 64;
+
+Broadphase::Broadphase() : cellSize(1.0f), maxRadius(0.0f), tableMask(MIN_TABLE_SIZE - 1) {}
+
+void Broadphase::Clear() {
+    proxies.clear();
+    maxRadius = 0.0f;
+}
+
+void Broadphase::Add(float x, float y, float radius, unsigned int layer, unsigned int mask, int user) {
+    BroadphaseProxy proxy = { x, y, radius, layer, mask, user };
+    proxies.push_back(proxy);
+    if (radius > maxRadius) maxRadius = radius;
+}
+
+int Broadphase::CellHash(int cellX, int cellY) const {
+    unsigned int h = static_cast<unsigned int>(cellX) * 73856093u ^ static_cast<unsigned int>(cellY) * 19349663u;
+    return static_cast<int>(h & static_cast<unsigned int>(tableMask));
+}
+
+// ordena os proxies por balde: conta, soma prefixada e distribui
+void Broadphase::Build() {
+    int count = static_cast<int>(proxies.size());
+    cellSize = maxRadius > 0.0f ? maxRadius * 2.0f : 1.0f;
+
+    // tabela com pelo menos o dobro de baldes que proxies, potência de 2
+    int tableSize = MIN_TABLE_SIZE;
+    while (tableSize < count * 2) tableSize *= 2;
+    tableMask = tableSize - 1;
+
+    cellOf.resize(count);
+    cellStart.assign(tableSize + 1, 0);
+    sortedProxies.resize(count);
+
+    // conta em cellStart[balde]; a soma prefixada deixa ali o fim de cada balde
+    for (int i = 0; i < count; i++) {
+        int cellX = static_cast<int>(std::floor(proxies[i].x / cellSize));
+        int cellY = static_cast<int>(std::floor(proxies[i].y / cellSize));
+        cellOf[i] = CellHash(cellX, cellY);
+        cellStart[cellOf[i]]++;
+    }
+    for (int c = 1; c <= tableSize; c++) {
+        cellStart[c] += cellStart[c - 1];
+    }
+
+    // distribui de trás para frente; no fim cellStart[balde] volta a ser o início
+    for (int i = count - 1; i >= 0; i--) {
+        sortedProxies[--cellStart[cellOf[i]]] = i;
+    }
+}
+
+void Broadphase::FindPairs(std::vector<BroadphasePair>& pairs) {
+    pairs.clear();
+    if (proxies.size() < 2) return;
+    Build();
+
+    int count = static_cast<int>(proxies.size());
+    for (int i = 0; i < count; i++) {
+        const BroadphaseProxy& a = proxies[i];
+        // sem máscara o proxy não procura vizinhos: quem o procura são os proxies que
+        // incluem a camada dele. muitos objetos passivos juntos não custam pares entre si
+        if (a.mask == 0) continue;
+
+        int cellX = static_cast<int>(std::floor(a.x / cellSize));
+        int cellY = static_cast<int>(std::floor(a.y / cellSize));
+
+        // baldes das 9 células vizinhas, sem repetir (células diferentes podem cair no mesmo balde)
+        int buckets[9];
+        int numBuckets = 0;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int bucket = CellHash(cellX + dx, cellY + dy);
+                bool seen = false;
+                for (int k = 0; k < numBuckets; k++) {
+                    if (buckets[k] == bucket) { seen = true; break; }
+                }
+                if (!seen) buckets[numBuckets++] = bucket;
+            }
+        }
+
+        for (int k = 0; k < numBuckets; k++) {
+            for (int s = cellStart[buckets[k]]; s < cellStart[buckets[k] + 1]; s++) {
+                int j = sortedProxies[s];
+                const BroadphaseProxy& b = proxies[j];
+                // cada par sai uma vez: pelo menor índice, ou pelo único lado que procura
+                if (j == i || (j < i && b.mask != 0)) continue;
+                if (!(a.layer & b.mask) && !(b.layer & a.mask)) continue;
+
+                float dx = b.x - a.x;
+                float dy = b.y - a.y;
+                float r = a.radius + b.radius;
+                if (dx * dx + dy * dy > r * r) continue;
+
+                BroadphasePair pair = { std::min(i, j), std::max(i, j) };
+                pairs.push_back(pair);
+            }
+        }
+    }
+}
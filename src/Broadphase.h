@@ -0,0 +1,54 @@
+/**
+ * Broadphase.h
+ * Fase ampla da detecção de colisão: uma grade uniforme refeita a cada passo.
+ * Cada objeto entra como um círculo envolvente com uma camada e uma máscara;
+ * FindPairs devolve, numa única passada, todos os pares que se sobrepõem e
+ * que podem interagir. Os testes exatos ficam para quem usa os pares.
+ */
+
+#ifndef __BROADPHASE_H__
+#define __BROADPHASE_H__
+
+#include <vector>
+
+struct BroadphaseProxy {
+    float x, y;
+    float radius;
+    unsigned int layer;  // bit do grupo do objeto
+    unsigned int mask;   // grupos com os quais ele interage
+    int user;            // índice do objeto para quem chamou
+};
+
+struct BroadphasePair {
+    int a, b; // índices dos proxies, a < b
+};
+
+class Broadphase {
+public:
+    Broadphase();
+
+    // começa um novo passo; a memória dos vetores é reaproveitada
+    void Clear();
+    // mask 0 marca um objeto passivo: só aparece nos pares de quem procura a camada dele
+    void Add(float x, float y, float radius, unsigned int layer, unsigned int mask, int user);
+
+    // monta a grade e preenche pairs com todos os pares sobrepostos (sem repetição)
+    void FindPairs(std::vector<BroadphasePair>& pairs);
+
+    const BroadphaseProxy& GetProxy(int index) const { return proxies[index]; }
+    int GetProxyCount() const { return static_cast<int>(proxies.size()); }
+
+private:
+    std::vector<BroadphaseProxy> proxies;
+    std::vector<int> cellOf;      // balde da tabela de cada proxy
+    std::vector<int> cellStart;   // início de cada balde em sortedProxies (tamanho = baldes + 1)
+    std::vector<int> sortedProxies;
+    float cellSize;
+    float maxRadius;
+    int tableMask;
+
+    int CellHash(int cellX, int cellY) const;
+    void Build();
+};
+
+#endif
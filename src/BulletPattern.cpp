@@ -0,0 +1,67 @@
+/**
+ * BulletPattern.cpp
+ * Tabela dos padrões de tiro e o cálculo das direções de cada disparo.
+ */
+
+#include "BulletPattern.h"
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// em ordem de dificuldade; o nível escolhe até onde a tabela pode ser usada
+static const BulletPattern PATTERNS[] = {
+    // nome       tipo                  tiros  abertura  giro   rajada  intervalo  recarga  velocidade
+    { "single",  PatternKind::Aimed,    1,     0.0f,     0.0f,  1,      0,         90,      2.5f },
+    { "burst",   PatternKind::Aimed,    1,     0.0f,     0.0f,  4,      8,         120,     3.0f },
+    { "spread",  PatternKind::Spread,   5,     0.8f,     0.0f,  1,      0,         100,     2.5f },
+    { "ring",    PatternKind::Ring,     16,    0.0f,     0.0f,  1,      0,         140,     2.0f },
+    { "spiral",  PatternKind::Spiral,   4,     0.0f,     0.2f,  40,     4,         180,     2.2f },
+    { "curtain", PatternKind::Ring,     48,    0.0f,     0.0f,  3,      10,        200,     1.8f },
+};
+
+static const int NUM_PATTERNS = sizeof(PATTERNS) / sizeof(PATTERNS[0]);
+
+int GetBulletPatternCount() {
+    return NUM_PATTERNS;
+}
+
+const BulletPattern& GetBulletPattern(int index) {
+    return PATTERNS[std::max(0, std::min(index, NUM_PATTERNS - 1))];
+}
+
+int EmitPatternDirections(const BulletPattern& pattern, float aimAngle, float spinAngle,
+                          float* dirX, float* dirY) {
+    int count = std::min(pattern.bulletsPerShot, MAX_BULLETS_PER_SHOT);
+    if (count <= 0) return 0;
+
+    float first = aimAngle;
+    float step = 0.0f;
+    switch (pattern.kind) {
+    case PatternKind::Aimed:
+        break;
+    case PatternKind::Spread:
+        // o leque vai de -arc/2 a +arc/2 em volta da mira
+        if (count > 1) {
+            first = aimAngle - pattern.arc * 0.5f;
+            step = pattern.arc / (count - 1);
+        }
+        break;
+    case PatternKind::Ring:
+        step = 2.0f * static_cast<float>(M_PI) / count;
+        break;
+    case PatternKind::Spiral:
+        first = spinAngle;
+        step = 2.0f * static_cast<float>(M_PI) / count;
+        break;
+    }
+
+    for (int i = 0; i < count; i++) {
+        float angle = first + step * i;
+        dirX[i] = std::cos(angle);
+        dirY[i] = std::sin(angle);
+    }
+    return count;
+}
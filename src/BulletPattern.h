@@ -0,0 +1,39 @@
+/**
+ * BulletPattern.h
+ * Padrões de tiro dos atiradores (leque, espiral, anel e rajada mirada),
+ * descritos só por dados: cada padrão diz quantos projéteis saem por disparo,
+ * como se espalham, quantos disparos formam uma rajada e o tempo entre elas.
+ */
+
+#ifndef __BULLET_PATTERN_H__
+#define __BULLET_PATTERN_H__
+
+enum class PatternKind {
+    Aimed,   // todos os projéteis na direção do tanque
+    Spread,  // leque centrado no tanque
+    Ring,    // volta inteira, começando na direção do tanque
+    Spiral   // volta inteira que gira a cada disparo, sem mirar
+};
+
+struct BulletPattern {
+    const char* name;
+    PatternKind kind;
+    int bulletsPerShot;
+    float arc;               // abertura do leque em radianos
+    float spinPerShot;       // giro somado a cada disparo da espiral
+    int shotsPerBurst;
+    int framesBetweenShots;  // dentro da rajada
+    int cooldown;            // passos entre o fim de uma rajada e o começo da próxima
+    float speed;
+};
+
+static const int MAX_BULLETS_PER_SHOT = 64;
+
+int GetBulletPatternCount();
+const BulletPattern& GetBulletPattern(int index);
+
+// direções unitárias de um disparo em dirX/dirY (até MAX_BULLETS_PER_SHOT); retorna quantas
+int EmitPatternDirections(const BulletPattern& pattern, float aimAngle, float spinAngle,
+                          float* dirX, float* dirY);
+
+#endif
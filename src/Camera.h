@@ -0,0 +1,89 @@
+/**
+ * Camera.h
+ * Câmera 2D com deslocamento e zoom.
+ * Converte coordenadas entre tela e mundo (usada pelo mouse nos dois modos)
+ * e responde se círculos ou caixas do mundo estão visíveis, para o culling.
+ */
+
+#ifndef __CAMERA_H__
+#define __CAMERA_H__
+
+#include <cmath>
+#include "Vector2.h"
+#include "gl_canvas2d.h"
+
+class Camera {
+public:
+    Vector2 center;      // ponto do mundo que aparece no centro da tela
+    float zoom;          // pixels de tela por unidade do mundo
+    float viewportWidth;
+    float viewportHeight;
+
+    static constexpr float MIN_ZOOM = 0.25f;
+    static constexpr float MAX_ZOOM = 4.0f;
+
+    Camera() : center(0, 0), zoom(1.0f), viewportWidth(1280), viewportHeight(720) {}
+
+    Camera(float width, float height)
+        : center(width / 2.0f, height / 2.0f), zoom(1.0f), viewportWidth(width), viewportHeight(height) {}
+
+    void SetViewport(float width, float height) {
+        viewportWidth = width;
+        viewportHeight = height;
+    }
+
+    Vector2 WorldToScreen(const Vector2& world) const {
+        return Vector2((world.x - center.x) * zoom + viewportWidth / 2.0f,
+                       (world.y - center.y) * zoom + viewportHeight / 2.0f);
+    }
+
+    Vector2 ScreenToWorld(float screenX, float screenY) const {
+        return Vector2((screenX - viewportWidth / 2.0f) / zoom + center.x,
+                       (screenY - viewportHeight / 2.0f) / zoom + center.y);
+    }
+
+    // desloca a câmera por uma distância em pixels de tela
+    void Pan(float screenDx, float screenDy) {
+        center.x -= screenDx / zoom;
+        center.y -= screenDy / zoom;
+    }
+
+    // aplica o zoom mantendo fixo o ponto do mundo sob (screenX, screenY)
+    void ZoomAt(float factor, float screenX, float screenY) {
+        Vector2 before = ScreenToWorld(screenX, screenY);
+        zoom *= factor;
+        if (zoom < MIN_ZOOM) zoom = MIN_ZOOM;
+        if (zoom > MAX_ZOOM) zoom = MAX_ZOOM;
+        Vector2 after = ScreenToWorld(screenX, screenY);
+        center.x += before.x - after.x;
+        center.y += before.y - after.y;
+    }
+
+    // limites do mundo visíveis na tela
+    void GetVisibleBounds(Vector2& boundsMin, Vector2& boundsMax) const {
+        float halfW = viewportWidth / (2.0f * zoom);
+        float halfH = viewportHeight / (2.0f * zoom);
+        boundsMin.set(center.x - halfW, center.y - halfH);
+        boundsMax.set(center.x + halfW, center.y + halfH);
+    }
+
+    bool IsCircleVisible(const Vector2& circleCenter, float radius) const {
+        float halfW = viewportWidth / (2.0f * zoom) + radius;
+        float halfH = viewportHeight / (2.0f * zoom) + radius;
+        return std::fabs(circleCenter.x - center.x) <= halfW && std::fabs(circleCenter.y - center.y) <= halfH;
+    }
+
+    bool IsBoxVisible(const Vector2& boxMin, const Vector2& boxMax) const {
+        Vector2 viewMin, viewMax;
+        GetVisibleBounds(viewMin, viewMax);
+        return boxMax.x >= viewMin.x && boxMin.x <= viewMax.x &&
+               boxMax.y >= viewMin.y && boxMin.y <= viewMax.y;
+    }
+
+    // configura a matriz de desenho para coordenadas do mundo
+    void Apply() const {
+        CV::transform(viewportWidth / 2.0f - center.x * zoom, viewportHeight / 2.0f - center.y * zoom, zoom);
+    }
+};
+
+#endif
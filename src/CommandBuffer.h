@@ -0,0 +1,65 @@
+/**
+ * CommandBuffer.h
+ * Mudanças estruturais do jogo (criar e destruir alvos, passar de nível)
+ * pedidas durante o passo de simulação. Os sistemas só registram os comandos
+ * enquanto percorrem os alvos; quem os executa é uma única passada no fim do
+ * passo, então nenhum laço vê os vetores mudarem no meio.
+ */
+
+#ifndef __COMMAND_BUFFER_H__
+#define __COMMAND_BUFFER_H__
+
+#include <vector>
+#include "Vector2.h"
+#include "Target.h"
+
+enum class CommandType {
+    SpawnTarget,    // cria um alvo do tipo e na posição dados
+    DestroyTarget,  // conta um alvo destruído (e os pontos dele)
+    LevelUp         // passa de nível e recria os alvos
+};
+
+struct GameCommand {
+    CommandType type;
+    int id;                 // alvo em DestroyTarget
+    TargetType targetType;  // tipo em SpawnTarget
+    Vector2 position;       // posição em SpawnTarget
+};
+
+class CommandBuffer {
+public:
+    CommandBuffer() { commands.reserve(64); }
+
+    void SpawnTarget(const Vector2& position, TargetType type) {
+        Push(CommandType::SpawnTarget, -1, type, position);
+    }
+
+    // registrado uma vez por alvo, quando ele deixa de estar ativo
+    void DestroyTarget(int id) {
+        Push(CommandType::DestroyTarget, id, TargetType::Basic, Vector2());
+    }
+
+    void LevelUp() {
+        Push(CommandType::LevelUp, -1, TargetType::Basic, Vector2());
+    }
+
+    int Count() const { return static_cast<int>(commands.size()); }
+    const GameCommand& Get(int index) const { return commands[index]; }
+
+    // descarta o que ainda não foi executado, mantendo a memória
+    void Clear() { commands.clear(); }
+
+private:
+    std::vector<GameCommand> commands;
+
+    void Push(CommandType type, int id, TargetType targetType, const Vector2& position) {
+        GameCommand command;
+        command.type = type;
+        command.id = id;
+        command.targetType = targetType;
+        command.position = position;
+        commands.push_back(command);
+    }
+};
+
+#endif
@@ -0,0 +1,160 @@
+/**
+ * DecalLayer.cpp
+ * Implementa o carimbo das marcas nas texturas dos blocos e a composição no mundo.
+ * As texturas começam brancas e são multiplicadas pela cor da pista,
+ * então as marcas escurecem o chão e se acumulam umas sobre as outras.
+ */
+
+#include "DecalLayer.h"
+#include "Camera.h"
+#include "gl_canvas2d.h"
+#include <cmath>
+
+static const int SCORCH_SIDES = 12;
+static const float TREAD_LENGTH = 4.0f;  // comprimento de cada marca da esteira
+static const float TREAD_WIDTH = 5.0f;
+
+DecalLayer::DecalLayer() {}
+
+DecalLayer::Tile* DecalLayer::GetTile(int tileX, int tileY) {
+    long long key = (static_cast<long long>(tileX) << 32) ^ static_cast<unsigned int>(tileY);
+    auto it = tileIndex.find(key);
+    if (it != tileIndex.end()) return &tiles[it->second];
+
+    // fora do limite de blocos a marca é ignorada
+    if (static_cast<int>(tiles.size()) >= MAX_TILES) return nullptr;
+
+    Tile tile;
+    tile.tileX = tileX;
+    tile.tileY = tileY;
+    tile.texture = 0;
+    tile.hasContent = false;
+    tile.dirty = false;
+    tileIndex[key] = static_cast<int>(tiles.size());
+    tiles.push_back(tile);
+    return &tiles.back();
+}
+
+void DecalLayer::AddStamp(const DecalStamp& stamp) {
+    if (stamp.kind == DecalKind::Clear) {
+        Clear();
+        return;
+    }
+
+    // a marca vai para todos os blocos que ela toca (até 4)
+    float reach = stamp.size + TREAD_LENGTH;
+    int x0 = static_cast<int>(std::floor((stamp.position.x - reach) / TILE_WORLD_SIZE));
+    int x1 = static_cast<int>(std::floor((stamp.position.x + reach) / TILE_WORLD_SIZE));
+    int y0 = static_cast<int>(std::floor((stamp.position.y - reach) / TILE_WORLD_SIZE));
+    int y1 = static_cast<int>(std::floor((stamp.position.y + reach) / TILE_WORLD_SIZE));
+    for (int ty = y0; ty <= y1; ty++) {
+        for (int tx = x0; tx <= x1; tx++) {
+            Tile* tile = GetTile(tx, ty);
+            if (!tile) continue;
+            tile->pending.push_back(stamp);
+            if (!tile->dirty) {
+                tile->dirty = true;
+                dirtyTiles.push_back(static_cast<int>(tile - &tiles[0]));
+            }
+        }
+    }
+}
+
+// as texturas ficam alocadas para serem reaproveitadas no próximo jogo
+void DecalLayer::Clear() {
+    for (Tile& tile : tiles) {
+        tile.hasContent = false;
+        tile.dirty = false;
+        tile.pending.clear();
+    }
+    dirtyTiles.clear();
+}
+
+void DecalLayer::Update(int screenWidth, int screenHeight) {
+    DecalStamp stamp;
+    while (Stamps().Pop(stamp)) {
+        AddStamp(stamp);
+    }
+
+    // o bloco é desenhado no canto da janela, que precisa ser grande o bastante
+    if (screenWidth < TILE_TEXELS || screenHeight < TILE_TEXELS) return;
+
+    int updates = 0;
+    while (!dirtyTiles.empty() && updates < MAX_TILE_UPDATES_PER_FRAME) {
+        Tile& tile = tiles[dirtyTiles.back()];
+        dirtyTiles.pop_back();
+        tile.dirty = false;
+        RedrawTile(tile);
+        updates++;
+    }
+}
+
+// desenha a textura atual do bloco, carimba as marcas novas por cima e copia de volta
+void DecalLayer::RedrawTile(Tile& tile) {
+    CV::beginTextureRender(TILE_TEXELS, TILE_TEXELS);
+    if (tile.hasContent) {
+        CV::texturedRect(tile.texture, 0, 0, TILE_TEXELS, TILE_TEXELS);
+    } else {
+        CV::color(1.0f, 1.0f, 1.0f);
+        CV::rectFill(0, 0, TILE_TEXELS, TILE_TEXELS);
+    }
+
+    float scale = TILE_TEXELS / TILE_WORLD_SIZE;
+    CV::transform(-tile.tileX * TILE_WORLD_SIZE * scale, -tile.tileY * TILE_WORLD_SIZE * scale, scale);
+    CV::multiplyBlend(true);
+    for (const DecalStamp& stamp : tile.pending) {
+        DrawStamp(stamp);
+    }
+    CV::multiplyBlend(false);
+
+    CV::endTextureRender(tile.texture, TILE_TEXELS, TILE_TEXELS);
+    tile.hasContent = true;
+    tile.pending.clear();
+}
+
+void DecalLayer::DrawStamp(const DecalStamp& stamp) {
+    float c = std::cos(stamp.angle);
+    float s = std::sin(stamp.angle);
+
+    if (stamp.kind == DecalKind::Scorch) {
+        // borda irregular que depende do ângulo do tiro, para as marcas não ficarem iguais
+        float vx[SCORCH_SIDES], vy[SCORCH_SIDES];
+        float radii[2] = { stamp.size, stamp.size * 0.55f };
+        float shades[2] = { 0.65f, 0.6f };
+        for (int ring = 0; ring < 2; ring++) {
+            for (int i = 0; i < SCORCH_SIDES; i++) {
+                float a = stamp.angle + i * PI_2 / SCORCH_SIDES;
+                float r = radii[ring] * (0.8f + 0.2f * std::sin(i * 2.7f + stamp.angle * 5.0f));
+                vx[i] = stamp.position.x + std::cos(a) * r;
+                vy[i] = stamp.position.y + std::sin(a) * r;
+            }
+            CV::color(shades[ring], shades[ring] * 0.95f, shades[ring] * 0.9f);
+            CV::polygonFill(vx, vy, SCORCH_SIDES);
+        }
+    } else if (stamp.kind == DecalKind::Tread) {
+        // um retângulo por esteira, alinhado com a base do tanque
+        CV::color(0.85f, 0.83f, 0.8f);
+        for (int side = -1; side <= 1; side += 2) {
+            Vector2 center(stamp.position.x - s * side * stamp.size * 0.5f,
+                           stamp.position.y + c * side * stamp.size * 0.5f);
+            float hl = TREAD_LENGTH * 0.5f, hw = TREAD_WIDTH * 0.5f;
+            float vx[4] = { center.x + c * hl - s * hw, center.x + c * hl + s * hw,
+                            center.x - c * hl + s * hw, center.x - c * hl - s * hw };
+            float vy[4] = { center.y + s * hl + c * hw, center.y + s * hl - c * hw,
+                            center.y - s * hl - c * hw, center.y - s * hl + c * hw };
+            CV::polygonFill(vx, vy, 4);
+        }
+    }
+}
+
+void DecalLayer::Render(const Camera& view) const {
+    CV::multiplyBlend(true);
+    for (const Tile& tile : tiles) {
+        if (!tile.hasContent) continue;
+        Vector2 tileMin(tile.tileX * TILE_WORLD_SIZE, tile.tileY * TILE_WORLD_SIZE);
+        Vector2 tileMax(tileMin.x + TILE_WORLD_SIZE, tileMin.y + TILE_WORLD_SIZE);
+        if (!view.IsBoxVisible(tileMin, tileMax)) continue;
+        CV::texturedRect(tile.texture, tileMin.x, tileMin.y, tileMax.x, tileMax.y);
+    }
+    CV::multiplyBlend(false);
+}
@@ -0,0 +1,84 @@
+/**
+ * DecalLayer.h
+ * Camada persistente de marcas no chão (queimaduras dos tiros e rastro das esteiras).
+ * Cada marca é carimbada uma única vez em texturas do mundo divididas em blocos,
+ * e a cada quadro só os blocos visíveis são compostos por cima da pista.
+ * O custo não cresce com o número de marcas acumuladas.
+ */
+
+#ifndef __DECAL_LAYER_H__
+#define __DECAL_LAYER_H__
+
+#include <unordered_map>
+#include <vector>
+
+#include "SpscQueue.h"
+#include "Vector2.h"
+
+class Camera;
+
+enum class DecalKind {
+    Scorch,   // queimadura no ponto de impacto de um tiro
+    Tread,    // marca das duas esteiras do tanque
+    Clear     // apaga todas as marcas (novo jogo)
+};
+
+struct DecalStamp {
+    DecalKind kind;
+    Vector2 position;
+    float angle;   // radianos
+    float size;    // raio da queimadura ou distância entre as esteiras
+};
+
+class DecalLayer {
+public:
+    static const int TILE_TEXELS = 256;                  // lado da textura de cada bloco (potência de 2)
+    static constexpr float TILE_WORLD_SIZE = 256.0f;     // lado do bloco em unidades do mundo
+    static const int MAX_TILES = 64;
+    static const int MAX_TILE_UPDATES_PER_FRAME = 4;     // blocos recarimbados por quadro; o resto fica para depois
+
+    typedef SpscQueue<DecalStamp, 1024> StampQueue;
+
+    // fila de marcas novas: simulação -> renderização
+    static StampQueue& Stamps() {
+        static StampQueue queue;
+        return queue;
+    }
+
+    // chamado pela thread de simulação; se a fila estiver cheia a marca é descartada
+    static void Stamp(DecalKind kind, const Vector2& position, float angle, float size) {
+        DecalStamp stamp = { kind, position, angle, size };
+        Stamps().Push(stamp);
+    }
+
+    DecalLayer();
+
+    // carimba as marcas pendentes nos blocos. deve ser chamado antes de limpar a tela,
+    // pois usa o canto da janela como área de desenho
+    void Update(int screenWidth, int screenHeight);
+
+    // compõe os blocos visíveis sobre o que já foi desenhado (coordenadas do mundo)
+    void Render(const Camera& view) const;
+
+private:
+    struct Tile {
+        int tileX, tileY;
+        unsigned int texture;
+        bool hasContent;     // textura já tem marcas
+        bool dirty;          // está na lista de blocos a recarimbar
+        std::vector<DecalStamp> pending;
+    };
+
+    std::vector<Tile> tiles;
+    std::unordered_map<long long, int> tileIndex;   // (tileX, tileY) -> posição em tiles
+    std::vector<int> dirtyTiles;
+
+    Tile* GetTile(int tileX, int tileY);
+    void AddStamp(const DecalStamp& stamp);
+    void Clear();
+    void RedrawTile(Tile& tile);
+
+    static void DrawStamp(const DecalStamp& stamp);
+};
+
+#endif
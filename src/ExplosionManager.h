@@ -1,8 +1,10 @@
 /**
  * ExplosionManager.h
  * Sistema de partículas para gerenciar efeitos visuais de explosão.
- * Controla a criação, atualização e renderização de partículas
- * para criar efeitos realistas de explosão após colisões.
+ * As partículas vivas ficam juntas no começo de vetores de tamanho fixo,
+ * um por campo (estrutura de arrays): criar é O(1), a atualização usa SSE
+ * quando disponível e partículas mortas saem trocando de lugar com a última.
+ * Existe um único sistema de efeitos no jogo, compartilhado por todos os tanques.
  */
 
 #ifndef __EXPLOSION_MANAGER_H__
@@ -10,89 +12,68 @@
 
 #include "Vector2.h"
 #include "gl_canvas2d.h"
-#include <vector>
+#include "Camera.h"
+#include <algorithm>
 #include <cstdlib>
 #include <cmath>
+#include <atomic>
 
-// uma única partícula em uma explosão
-struct ExplosionParticle {
-    Vector2 position;
-    Vector2 velocity;
-    float size;
-    float lifetime;
-    float maxLifetime;
-    float r, g, b;  // valores de cor RGB
-    bool active;
-    
-    ExplosionParticle() : position(), velocity(), size(0), 
-                          lifetime(0), maxLifetime(0), 
-                          r(0), g(0), b(0), active(false) {}
-    
-    void Update() {
-        if (!active) return;
-        
-        position = position + velocity;
-        lifetime--;
-        
-        // desacelera gradualmente
-        velocity = velocity * 0.95f;
-        
-        // desativa quando o tempo de vida acabar
-        if (lifetime <= 0) {
-            active = false;
-        }
-    }
-    
-    void Render() {
-        if (!active) return;
-        
-        // calcula alpha (desaparece conforme o tempo de vida diminui)
-        float alpha = lifetime / maxLifetime;
-        
-        // renderiza a partícula com cor e alpha
-        CV::color(r, g*alpha, b*alpha, alpha);
-        CV::circleFill(position.x, position.y, size*alpha, 10);
-        
-        // adiciona efeito de brilho
-        CV::color(r, g, b, alpha * 0.5f);
-        CV::circleFill(position.x, position.y, size*1.5f*alpha, 8);
-    }
-};
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define EXPLOSION_USE_SSE 1
+#endif
 
-// gerencia múltiplas explosões
 class ExplosionManager {
-private:
-    std::vector<ExplosionParticle> particles;
-    
 public:
-    ExplosionManager() {}
+    static const int MAX_PARTICLES = 2048;   // múltiplo de 4 para o laço com SSE
+    static constexpr float VELOCITY_DAMPING = 0.95f;
+
+    ExplosionManager() : count(0) {
+        // zera também a folga depois das partículas vivas, que o laço com SSE lê
+        Fill(posX); Fill(posY); Fill(prevX); Fill(prevY); Fill(velX); Fill(velY);
+        Fill(size); Fill(lifetime); Fill(maxLifetime); Fill(r); Fill(g); Fill(b);
+    }
+
+    // a cópia (usada no snapshot) só leva as partículas vivas
+    ExplosionManager(const ExplosionManager& other) : count(0) {
+        *this = other;
+    }
+
+    ExplosionManager& operator=(const ExplosionManager& other) {
+        if (this == &other) return *this;
+        count = other.count;
+        Copy(posX, other.posX); Copy(posY, other.posY);
+        Copy(prevX, other.prevX); Copy(prevY, other.prevY);
+        Copy(velX, other.velX); Copy(velY, other.velY);
+        Copy(size, other.size); Copy(lifetime, other.lifetime); Copy(maxLifetime, other.maxLifetime);
+        Copy(r, other.r); Copy(g, other.g); Copy(b, other.b);
+        return *this;
+    }
+
+    // fração das partículas realmente emitidas, ajustada pelo controle de qualidade (outra thread)
+    static std::atomic<float>& EmissionScale() {
+        static std::atomic<float> scale(1.0f);
+        return scale;
+    }
+
+    int GetCount() const { return count; }
     
     void CreateExplosion(const Vector2& position, const Vector2& direction, int particleCount = 20) {
+        particleCount = static_cast<int>(particleCount * EmissionScale().load(std::memory_order_relaxed));
+        if (particleCount < 1) particleCount = 1;
+
+        // sem espaço, a explosão sai com menos partículas
+        particleCount = std::min(particleCount, MAX_PARTICLES - count);
+
         // calcula direção normalizada e vetor perpendicular
         Vector2 normalizedDir = direction.normalized();
         Vector2 perpDir(-normalizedDir.y, normalizedDir.x);
         
-        // reutiliza partículas inativas ou adiciona novas se necessário
-        for (int i = 0; i < particleCount; i++) {
-            ExplosionParticle particle;
-            
-            // encontra partícula inativa ou adiciona uma nova
-            bool foundInactive = false;
-            for (size_t j = 0; j < particles.size(); j++) {
-                if (!particles[j].active) {
-                    particle = particles[j];
-                    foundInactive = true;
-                    break;
-                }
-            }
-            
-            if (!foundInactive) {
-                particles.push_back(particle);
-                particle = particles.back();
-            }
-            
-            // configura propriedades da partícula
-            particle.position = position;
+        for (int n = 0; n < particleCount; n++) {
+            int i = count++;
+
+            posX[i] = prevX[i] = position.x;
+            posY[i] = prevY[i] = position.y;
             
             // calcula velocidade aleatória baseada na direção
             float speed = 2.0f + (rand() % 300) / 100.0f;  // 2.0 a 5.0
@@ -107,66 +88,129 @@ public:
             
             // adiciona alguma aleatoriedade à dispersão
             float sidewaysSpeed = ((rand() % 200) - 100) / 100.0f;  // -1.0 a 1.0
-            particle.velocity = spreadDir * speed + perpDir * sidewaysSpeed;
+            velX[i] = spreadDir.x * speed + perpDir.x * sidewaysSpeed;
+            velY[i] = spreadDir.y * speed + perpDir.y * sidewaysSpeed;
             
             // tamanho aleatório (3-8 pixels)
-            particle.size = 3.0f + (rand() % 50) / 10.0f;
+            size[i] = 3.0f + (rand() % 50) / 10.0f;
             
             // define tempo de vida (20-40 frames)
-            particle.maxLifetime = 20.0f + (rand() % 200) / 10.0f;
-            particle.lifetime = particle.maxLifetime;
+            maxLifetime[i] = 20.0f + (rand() % 200) / 10.0f;
+            lifetime[i] = maxLifetime[i];
             
             // escolhe cor - amarelo, laranja ou vermelho
             int colorType = rand() % 3;
+            r[i] = 1.0f;
+            b[i] = 0.0f;
             switch (colorType) {
                 case 0: // amarelo
-                    particle.r = 1.0f;
-                    particle.g = 0.9f + (rand() % 10) / 100.0f; // 0.9-1.0
-                    particle.b = 0.0f;
+                    g[i] = 0.9f + (rand() % 10) / 100.0f; // 0.9-1.0
                     break;
                 case 1: // laranja
-                    particle.r = 1.0f;
-                    particle.g = 0.5f + (rand() % 30) / 100.0f; // 0.5-0.8
-                    particle.b = 0.0f;
+                    g[i] = 0.5f + (rand() % 30) / 100.0f; // 0.5-0.8
                     break;
                 case 2: // vermelho
-                    particle.r = 1.0f;
-                    particle.g = 0.0f + (rand() % 30) / 100.0f; // 0.0-0.3
-                    particle.b = 0.0f;
+                    g[i] = 0.0f + (rand() % 30) / 100.0f; // 0.0-0.3
                     break;
             }
-            
-            // ativa partícula
-            particle.active = true;
-            
-            // atualiza a partícula no vetor
-            if (foundInactive) {
-                for (size_t j = 0; j < particles.size(); j++) {
-                    if (!particles[j].active) {
-                        particles[j] = particle;
-                        break;
-                    }
-                }
-            } else {
-                particles[particles.size() - 1] = particle;
-            }
         }
     }
     
     void Update() {
-        for (auto& particle : particles) {
-            particle.Update();
+        // move, desacelera e envelhece todas as partículas vivas
+#ifdef EXPLOSION_USE_SSE
+        const __m128 damping = _mm_set1_ps(VELOCITY_DAMPING);
+        const __m128 one = _mm_set1_ps(1.0f);
+        for (int i = 0; i < count; i += 4) {
+            __m128 px = _mm_load_ps(posX + i);
+            __m128 py = _mm_load_ps(posY + i);
+            __m128 vx = _mm_load_ps(velX + i);
+            __m128 vy = _mm_load_ps(velY + i);
+            _mm_store_ps(prevX + i, px);
+            _mm_store_ps(prevY + i, py);
+            _mm_store_ps(posX + i, _mm_add_ps(px, vx));
+            _mm_store_ps(posY + i, _mm_add_ps(py, vy));
+            _mm_store_ps(velX + i, _mm_mul_ps(vx, damping));
+            _mm_store_ps(velY + i, _mm_mul_ps(vy, damping));
+            _mm_store_ps(lifetime + i, _mm_sub_ps(_mm_load_ps(lifetime + i), one));
+        }
+#else
+        for (int i = 0; i < count; i++) {
+            prevX[i] = posX[i];
+            prevY[i] = posY[i];
+            posX[i] += velX[i];
+            posY[i] += velY[i];
+            velX[i] *= VELOCITY_DAMPING;
+            velY[i] *= VELOCITY_DAMPING;
+            lifetime[i] -= 1.0f;
+        }
+#endif
+
+        // remove as que morreram trazendo a última para o lugar
+        int i = 0;
+        while (i < count) {
+            if (lifetime[i] <= 0.0f) {
+                count--;
+                MoveParticle(count, i);
+            } else {
+                i++;
+            }
         }
     }
     
-    void Render() {
-        for (auto& particle : particles) {
-            particle.Render();
+    void Render(float interpolation = 1.0f, const Camera* view = nullptr) const {
+        for (int i = 0; i < count; i++) {
+            float drawX = prevX[i] + (posX[i] - prevX[i]) * interpolation;
+            float drawY = prevY[i] + (posY[i] - prevY[i]) * interpolation;
+            if (view && !view->IsCircleVisible(Vector2(drawX, drawY), size[i] * 1.5f)) continue;
+
+            // calcula alpha (desaparece conforme o tempo de vida diminui)
+            float alpha = lifetime[i] / maxLifetime[i];
+
+            // renderiza a partícula com cor e alpha
+            CV::color(r[i], g[i]*alpha, b[i]*alpha, alpha);
+            CV::circleFill(drawX, drawY, size[i]*alpha, 10);
+
+            // adiciona efeito de brilho
+            CV::color(r[i], g[i], b[i], alpha * 0.5f);
+            CV::circleFill(drawX, drawY, size[i]*1.5f*alpha, 8);
         }
     }
     
     void Clear() {
-        particles.clear();
+        count = 0;
+    }
+
+private:
+    // campos de cada partícula viva, de 0 até count
+    alignas(16) float posX[MAX_PARTICLES];
+    alignas(16) float posY[MAX_PARTICLES];
+    alignas(16) float prevX[MAX_PARTICLES];   // posição do passo anterior para interpolação
+    alignas(16) float prevY[MAX_PARTICLES];
+    alignas(16) float velX[MAX_PARTICLES];
+    alignas(16) float velY[MAX_PARTICLES];
+    alignas(16) float lifetime[MAX_PARTICLES];
+    float size[MAX_PARTICLES];
+    float maxLifetime[MAX_PARTICLES];
+    float r[MAX_PARTICLES], g[MAX_PARTICLES], b[MAX_PARTICLES];  // valores de cor RGB
+    int count;
+
+    static void Fill(float* field) {
+        std::fill(field, field + MAX_PARTICLES, 0.0f);
+    }
+
+    void Copy(float* field, const float* source) {
+        std::copy(source, source + count, field);
+    }
+
+    void MoveParticle(int from, int to) {
+        posX[to] = posX[from];   posY[to] = posY[from];
+        prevX[to] = prevX[from]; prevY[to] = prevY[from];
+        velX[to] = velX[from];   velY[to] = velY[from];
+        size[to] = size[from];
+        lifetime[to] = lifetime[from];
+        maxLifetime[to] = maxLifetime[from];
+        r[to] = r[from]; g[to] = g[from]; b[to] = b[from];
     }
 };
 
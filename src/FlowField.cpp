@@ -0,0 +1,312 @@
+/**
+ * FlowField.cpp
+ * Implementa a máscara do corredor (rasterizando os quadriláteros do
+ * preenchimento da pista), o Dijkstra com várias origens a partir das
+ * células dos tanques (na thread de cálculo) e a leitura suavizada da direção.
+ */
+
+#include "FlowField.h"
+#include "BSplineTrack.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+
+const int FlowField::UNREACHABLE;
+
+static const int STRAIGHT_COST = 10;
+static const int DIAGONAL_COST = 14;
+
+// vizinhas em 8 direções
+static const int NEIGHBOR_DX[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+static const int NEIGHBOR_DY[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+FlowField::FlowField()
+    : width(0), height(0), origin(0, 0), numJobGoals(0), numGoalCells(0), goalsDirty(false),
+      trackRevision(0), hasMask(false), jobState(JOB_IDLE), workerRunning(false) {}
+
+FlowField::~FlowField() {
+    Stop();
+}
+
+void FlowField::Stop() {
+    workerRunning.store(false);
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void FlowField::WaitForJob() {
+    while (jobState.load() == JOB_QUEUED) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+int FlowField::CellIndex(const Vector2& position) const {
+    int cx = static_cast<int>(std::floor((position.x - origin.x) / CELL_SIZE));
+    int cy = static_cast<int>(std::floor((position.y - origin.y) / CELL_SIZE));
+    if (cx < 0 || cy < 0 || cx >= width || cy >= height) return -1;
+    return cy * width + cx;
+}
+
+static bool PointInTriangle(float px, float py, const Vector2& a, const Vector2& b, const Vector2& c) {
+    float d1 = (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+    float d2 = (c.x - b.x) * (py - b.y) - (c.y - b.y) * (px - b.x);
+    float d3 = (a.x - c.x) * (py - c.y) - (a.y - c.y) * (px - c.x);
+    bool hasNegative = d1 < 0 || d2 < 0 || d3 < 0;
+    bool hasPositive = d1 > 0 || d2 > 0 || d3 > 0;
+    return !(hasNegative && hasPositive);
+}
+
+void FlowField::BuildMask(const BSplineTrack& track) {
+    // a thread de cálculo lê a máscara: espera ela terminar e descarta o resultado, que é da pista antiga
+    WaitForJob();
+    jobState.store(JOB_IDLE);
+
+    const TrackGeometry& geo = track.GetGeometry();
+    trackRevision = track.revision;
+    hasMask = true;
+    numGoalCells = 0; // força o recálculo das distâncias
+
+    if (geo.left.size() < 2 || geo.chunks.empty()) {
+        width = height = 0;
+        passable.clear();
+        return;
+    }
+
+    Vector2 boundsMin = geo.chunks[0].boundsMin;
+    Vector2 boundsMax = geo.chunks[0].boundsMax;
+    for (size_t c = 1; c < geo.chunks.size(); c++) {
+        boundsMin.set(std::min(boundsMin.x, geo.chunks[c].boundsMin.x), std::min(boundsMin.y, geo.chunks[c].boundsMin.y));
+        boundsMax.set(std::max(boundsMax.x, geo.chunks[c].boundsMax.x), std::max(boundsMax.y, geo.chunks[c].boundsMax.y));
+    }
+
+    origin.set(boundsMin.x - CELL_SIZE, boundsMin.y - CELL_SIZE);
+    width = static_cast<int>((boundsMax.x - origin.x) / CELL_SIZE) + 2;
+    height = static_cast<int>((boundsMax.y - origin.y) / CELL_SIZE) + 2;
+
+    int numCells = width * height;
+    passable.assign(numCells, 0);
+    distance.assign(numCells, UNREACHABLE);
+    dirX.assign(numCells, 0.0f);
+    dirY.assign(numCells, 0.0f);
+    workDistance.assign(numCells, UNREACHABLE);
+    workDirX.assign(numCells, 0.0f);
+    workDirY.assign(numCells, 0.0f);
+
+    // cada faixa entre duas amostras é um quadrilátero (dois triângulos); marca as células com o centro dentro
+    for (size_t i = 0; i + 1 < geo.left.size(); i++) {
+        const Vector2& l0 = geo.left[i];
+        const Vector2& l1 = geo.left[i + 1];
+        const Vector2& r0 = geo.right[i];
+        const Vector2& r1 = geo.right[i + 1];
+
+        float minX = std::min(std::min(l0.x, l1.x), std::min(r0.x, r1.x));
+        float maxX = std::max(std::max(l0.x, l1.x), std::max(r0.x, r1.x));
+        float minY = std::min(std::min(l0.y, l1.y), std::min(r0.y, r1.y));
+        float maxY = std::max(std::max(l0.y, l1.y), std::max(r0.y, r1.y));
+
+        int x0 = std::max(0, static_cast<int>((minX - origin.x) / CELL_SIZE));
+        int x1 = std::min(width - 1, static_cast<int>((maxX - origin.x) / CELL_SIZE));
+        int y0 = std::max(0, static_cast<int>((minY - origin.y) / CELL_SIZE));
+        int y1 = std::min(height - 1, static_cast<int>((maxY - origin.y) / CELL_SIZE));
+
+        for (int cy = y0; cy <= y1; cy++) {
+            for (int cx = x0; cx <= x1; cx++) {
+                int index = cy * width + cx;
+                if (passable[index]) continue;
+                float px = origin.x + (cx + 0.5f) * CELL_SIZE;
+                float py = origin.y + (cy + 0.5f) * CELL_SIZE;
+                if (PointInTriangle(px, py, l0, l1, r1) || PointInTriangle(px, py, l0, r1, r0)) {
+                    passable[index] = 1;
+                }
+            }
+        }
+    }
+}
+
+void FlowField::Update(const BSplineTrack& track, const Vector2* goals, int numGoals) {
+    if (!hasMask || trackRevision != track.revision) {
+        BuildMask(track);
+    }
+    if (width == 0) return;
+
+    // o cálculo pedido antes terminou: passa a valer
+    if (jobState.load() == JOB_DONE) {
+        distance.swap(workDistance);
+        dirX.swap(workDirX);
+        dirY.swap(workDirY);
+        jobState.store(JOB_IDLE);
+    }
+
+    // só recalcula quando o conjunto de células dos tanques muda
+    int cells[MAX_GOALS];
+    int count = 0;
+    for (int g = 0; g < numGoals && count < MAX_GOALS; g++) {
+        int index = CellIndex(goals[g]);
+        if (index >= 0) cells[count++] = index;
+    }
+
+    bool changed = count != numGoalCells;
+    for (int g = 0; g < count && !changed; g++) {
+        changed = cells[g] != goalCells[g];
+    }
+    if (changed) {
+        numGoalCells = count;
+        for (int g = 0; g < count; g++) {
+            goalCells[g] = cells[g];
+        }
+        goalsDirty = true;
+    }
+
+    // com um cálculo em andamento o pedido espera; só a última posição dos tanques importa
+    if (!goalsDirty || jobState.load() != JOB_IDLE) return;
+    goalsDirty = false;
+
+    numJobGoals = numGoalCells;
+    for (int g = 0; g < numGoalCells; g++) {
+        jobGoals[g] = goalCells[g];
+    }
+
+    if (!worker.joinable()) {
+        workerRunning.store(true);
+        worker = std::thread(&FlowField::WorkerLoop, this);
+    }
+    jobState.store(JOB_QUEUED);
+}
+
+void FlowField::WorkerLoop() {
+    while (workerRunning.load()) {
+        if (jobState.load() != JOB_QUEUED) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        ComputeDistances();
+        jobState.store(JOB_DONE);
+    }
+}
+
+void FlowField::ComputeDistances() {
+    // escreve só nos buffers de trabalho; o campo em uso continua intacto
+    std::fill(workDistance.begin(), workDistance.end(), UNREACHABLE);
+
+    // heap de (custo << 32 | célula) com o menor no topo
+    heap.clear();
+    std::greater<long long> minFirst;
+    for (int g = 0; g < numJobGoals; g++) {
+        // a célula do tanque conta como livre mesmo se o centro dela cai fora da pista
+        workDistance[jobGoals[g]] = 0;
+        heap.push_back(jobGoals[g]);
+    }
+    std::make_heap(heap.begin(), heap.end(), minFirst);
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), minFirst);
+        long long entry = heap.back();
+        heap.pop_back();
+
+        int index = static_cast<int>(entry & 0xffffffffLL);
+        int cost = static_cast<int>(entry >> 32);
+        if (cost > workDistance[index]) continue; // entrada velha
+
+        int cx = index % width;
+        int cy = index / width;
+        for (int n = 0; n < 8; n++) {
+            int nx = cx + NEIGHBOR_DX[n];
+            int ny = cy + NEIGHBOR_DY[n];
+            if (nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+            int neighbor = ny * width + nx;
+            if (!passable[neighbor]) continue;
+
+            // na diagonal não corta o canto de uma parede
+            bool diagonal = n >= 4;
+            if (diagonal && (!passable[cy * width + nx] || !passable[ny * width + cx])) continue;
+
+            int newCost = cost + (diagonal ? DIAGONAL_COST : STRAIGHT_COST);
+            if (newCost < workDistance[neighbor]) {
+                workDistance[neighbor] = newCost;
+                heap.push_back((static_cast<long long>(newCost) << 32) | neighbor);
+                std::push_heap(heap.begin(), heap.end(), minFirst);
+            }
+        }
+    }
+
+    // direção de cada célula: para a vizinha de menor custo
+    for (int cy = 0; cy < height; cy++) {
+        for (int cx = 0; cx < width; cx++) {
+            int index = cy * width + cx;
+            workDirX[index] = workDirY[index] = 0.0f;
+            if (workDistance[index] == UNREACHABLE || workDistance[index] == 0) continue;
+
+            int best = workDistance[index];
+            for (int n = 0; n < 8; n++) {
+                int nx = cx + NEIGHBOR_DX[n];
+                int ny = cy + NEIGHBOR_DY[n];
+                if (nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+                int neighbor = ny * width + nx;
+                if (workDistance[neighbor] < best) {
+                    best = workDistance[neighbor];
+                    float length = n >= 4 ? 1.41421356f : 1.0f;
+                    workDirX[index] = NEIGHBOR_DX[n] / length;
+                    workDirY[index] = NEIGHBOR_DY[n] / length;
+                }
+            }
+        }
+    }
+}
+
+bool FlowField::SampleDirection(const Vector2& position, Vector2& direction) const {
+    int index = CellIndex(position);
+    if (index < 0 || distance[index] == 0) return false;
+
+    if (distance[index] == UNREACHABLE) {
+        // encostado na parede, numa célula com o centro fora da pista: volta para a vizinha mais perto do tanque
+        int cx = index % width;
+        int cy = index / width;
+        int best = UNREACHABLE;
+        for (int n = 0; n < 8; n++) {
+            int nx = cx + NEIGHBOR_DX[n];
+            int ny = cy + NEIGHBOR_DY[n];
+            if (nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+            int neighbor = ny * width + nx;
+            if (distance[neighbor] < best) {
+                best = distance[neighbor];
+                direction.set(origin.x + (nx + 0.5f) * CELL_SIZE - position.x, origin.y + (ny + 0.5f) * CELL_SIZE - position.y);
+            }
+        }
+        if (best == UNREACHABLE || direction.lengthSq() < 1e-6f) return false;
+        direction.normalize();
+        return true;
+    }
+
+    // mistura bilinear das 4 células em volta, ignorando as sem caminho, para a curva ficar suave
+    float fx = (position.x - origin.x) / CELL_SIZE - 0.5f;
+    float fy = (position.y - origin.y) / CELL_SIZE - 0.5f;
+    int x0 = static_cast<int>(std::floor(fx));
+    int y0 = static_cast<int>(std::floor(fy));
+    float tx = fx - x0;
+    float ty = fy - y0;
+
+    float sumX = 0.0f, sumY = 0.0f;
+    for (int j = 0; j < 2; j++) {
+        for (int i = 0; i < 2; i++) {
+            int cx = x0 + i, cy = y0 + j;
+            if (cx < 0 || cy < 0 || cx >= width || cy >= height) continue;
+            int cell = cy * width + cx;
+            if (distance[cell] == UNREACHABLE) continue;
+            float weight = (i ? tx : 1.0f - tx) * (j ? ty : 1.0f - ty);
+            sumX += dirX[cell] * weight;
+            sumY += dirY[cell] * weight;
+        }
+    }
+
+    float length = std::sqrt(sumX * sumX + sumY * sumY);
+    if (length < 1e-4f) {
+        // as vizinhas se anulam: usa só a célula do ponto
+        sumX = dirX[index];
+        sumY = dirY[index];
+        length = 1.0f;
+    }
+    direction.set(sumX / length, sumY / length);
+    return true;
+}
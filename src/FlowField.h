@@ -0,0 +1,82 @@
+/**
+ * FlowField.h
+ * Campo de direções sobre uma grade que cobre o corredor da pista.
+ * Cada célula guarda a distância, andando só por dentro da pista, até o tanque
+ * mais próximo e a direção para a vizinha mais perto dele. Quando algum tanque
+ * troca de célula o campo é refeito numa thread própria, num segundo conjunto
+ * de buffers; a simulação continua lendo o campo anterior até o novo ficar
+ * pronto e só então troca os dois. Qualquer número de estrelas perseguidoras
+ * apenas lê a direção da célula onde está.
+ */
+
+#ifndef __FLOW_FIELD_H__
+#define __FLOW_FIELD_H__
+
+#include "Vector2.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+class BSplineTrack;
+
+class FlowField {
+public:
+    static constexpr float CELL_SIZE = 16.0f;
+    static const int MAX_GOALS = 4;
+    static const int UNREACHABLE = 0x3fffffff;
+
+    FlowField();
+    ~FlowField();
+
+    // refaz a máscara quando a pista muda e pede as distâncias novas quando algum tanque muda de célula.
+    // um cálculo terminado desde a última chamada passa a valer aqui (thread de simulação)
+    void Update(const BSplineTrack& track, const Vector2* goals, int numGoals);
+
+    // espera a thread de cálculo terminar
+    void Stop();
+
+    // direção (normalizada) para chegar ao tanque mais próximo pelo corredor.
+    // false se o ponto está fora do campo ou já na célula de um tanque
+    bool SampleDirection(const Vector2& position, Vector2& direction) const;
+
+private:
+    // estado do cálculo: a simulação só mexe nos buffers de trabalho e na máscara em Idle
+    enum JobState {
+        JOB_IDLE,
+        JOB_QUEUED,   // pedido feito, a thread de cálculo é dona dos buffers de trabalho
+        JOB_DONE      // pronto para a troca
+    };
+
+    int width, height;
+    Vector2 origin;                      // canto mínimo da grade no mundo
+    std::vector<unsigned char> passable; // célula com o centro dentro da pista
+    std::vector<int> distance;           // custo até o tanque mais próximo (10 reto, 14 diagonal)
+    std::vector<float> dirX, dirY;       // direção para a vizinha de menor custo
+
+    // buffers escritos pela thread de cálculo, trocados com os de cima quando prontos
+    std::vector<int> workDistance;
+    std::vector<float> workDirX, workDirY;
+    std::vector<long long> heap;         // fila de prioridade do Dijkstra, reaproveitada
+    int jobGoals[MAX_GOALS];
+    int numJobGoals;
+
+    int goalCells[MAX_GOALS];            // células dos tanques no último Update
+    int numGoalCells;
+    bool goalsDirty;                     // as células mudaram e ainda não foram pedidas
+    unsigned int trackRevision;
+    bool hasMask;
+
+    std::atomic<int> jobState;
+    std::atomic<bool> workerRunning;
+    std::thread worker;
+
+    int CellIndex(const Vector2& position) const; // -1 fora da grade
+    void BuildMask(const BSplineTrack& track);
+    void WaitForJob();
+    void ComputeDistances();
+
+    // thread de cálculo
+    void WorkerLoop();
+};
+
+#endif
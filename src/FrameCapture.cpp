@@ -0,0 +1,445 @@
+/**
+ * FrameCapture.cpp
+ * Implementa a leitura assíncrona da tela e a escrita de PNG e Y4M.
+ * O PNG usa deflate sem compressão (blocos "stored"), que não precisa
+ * de biblioteca externa; o Y4M guarda o vídeo cru em YCbCr 4:2:0.
+ */
+
+#include "FrameCapture.h"
+#include "GLExtensions.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+// ---------- escrita de arquivos (thread de escrita) ----------
+
+static unsigned long Crc32(const unsigned char* data, size_t length, unsigned long crc) {
+    static unsigned long table[256];
+    static bool tableReady = false;
+    if (!tableReady) {
+        for (unsigned long n = 0; n < 256; n++) {
+            unsigned long c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320UL ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+        tableReady = true;
+    }
+
+    crc ^= 0xFFFFFFFFUL;
+    for (size_t i = 0; i < length; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFUL;
+}
+
+static void PutBigEndian32(std::vector<unsigned char>& out, unsigned long value) {
+    out.push_back(static_cast<unsigned char>((value >> 24) & 0xFF));
+    out.push_back(static_cast<unsigned char>((value >> 16) & 0xFF));
+    out.push_back(static_cast<unsigned char>((value >> 8) & 0xFF));
+    out.push_back(static_cast<unsigned char>(value & 0xFF));
+}
+
+static void WritePngChunk(FILE* file, const char* type, const std::vector<unsigned char>& data) {
+    std::vector<unsigned char> chunk;
+    PutBigEndian32(chunk, static_cast<unsigned long>(data.size()));
+    chunk.insert(chunk.end(), type, type + 4);
+    chunk.insert(chunk.end(), data.begin(), data.end());
+    unsigned long crc = Crc32(&chunk[4], chunk.size() - 4, 0);
+    PutBigEndian32(chunk, crc);
+    fwrite(chunk.data(), 1, chunk.size(), file);
+}
+
+// pixels RGB com a primeira linha embaixo (como o glReadPixels devolve)
+static bool WritePng(const std::string& path, const unsigned char* pixels, int width, int height) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+
+    static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    fwrite(signature, 1, sizeof(signature), file);
+
+    std::vector<unsigned char> header;
+    PutBigEndian32(header, width);
+    PutBigEndian32(header, height);
+    header.push_back(8);  // bits por canal
+    header.push_back(2);  // RGB
+    header.push_back(0);  // deflate
+    header.push_back(0);  // filtro adaptativo padrão
+    header.push_back(0);  // sem entrelaçamento
+    WritePngChunk(file, "IHDR", header);
+
+    // linhas de cima para baixo, cada uma com o byte de filtro 0 (nenhum)
+    size_t rowBytes = static_cast<size_t>(width) * 3;
+    std::vector<unsigned char> raw;
+    raw.reserve((rowBytes + 1) * height);
+    for (int y = height - 1; y >= 0; y--) {
+        raw.push_back(0);
+        const unsigned char* row = pixels + rowBytes * y;
+        raw.insert(raw.end(), row, row + rowBytes);
+    }
+
+    // fluxo zlib com blocos deflate sem compressão (até 65535 bytes cada)
+    std::vector<unsigned char> zlib;
+    zlib.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+    zlib.push_back(0x78);
+    zlib.push_back(0x01);
+    size_t offset = 0;
+    do {
+        size_t blockSize = raw.size() - offset;
+        if (blockSize > 65535) blockSize = 65535;
+        bool last = offset + blockSize == raw.size();
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back(static_cast<unsigned char>(blockSize & 0xFF));
+        zlib.push_back(static_cast<unsigned char>(blockSize >> 8));
+        zlib.push_back(static_cast<unsigned char>(~blockSize & 0xFF));
+        zlib.push_back(static_cast<unsigned char>((~blockSize >> 8) & 0xFF));
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + blockSize);
+        offset += blockSize;
+    } while (offset < raw.size());
+
+    // adler-32 dos dados sem compressão
+    unsigned long a = 1, b = 0;
+    for (size_t i = 0; i < raw.size(); i++) {
+        a = (a + raw[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    PutBigEndian32(zlib, (b << 16) | a);
+
+    WritePngChunk(file, "IDAT", zlib);
+    WritePngChunk(file, "IEND", std::vector<unsigned char>());
+
+    bool ok = ferror(file) == 0;
+    fclose(file);
+    return ok;
+}
+
+// converte um quadro RGB para YCbCr 4:2:0 (BT.601, faixa completa) e escreve no Y4M.
+// largura e altura são cortadas para números pares
+static void WriteY4mFrame(FILE* file, const unsigned char* pixels, int width, int height,
+                          std::vector<unsigned char>& planes) {
+    int w = width & ~1;
+    int h = height & ~1;
+    size_t lumaSize = static_cast<size_t>(w) * h;
+    size_t chromaSize = lumaSize / 4;
+    planes.resize(lumaSize + chromaSize * 2);
+    unsigned char* lumaPlane = &planes[0];
+    unsigned char* cbPlane = lumaPlane + lumaSize;
+    unsigned char* crPlane = cbPlane + chromaSize;
+
+    for (int y = 0; y < h; y++) {
+        const unsigned char* row = pixels + static_cast<size_t>(width) * 3 * (height - 1 - y);
+        for (int x = 0; x < w; x++) {
+            const unsigned char* p = row + x * 3;
+            lumaPlane[y * w + x] = static_cast<unsigned char>(0.299f * p[0] + 0.587f * p[1] + 0.114f * p[2] + 0.5f);
+        }
+    }
+
+    for (int y = 0; y < h / 2; y++) {
+        const unsigned char* row0 = pixels + static_cast<size_t>(width) * 3 * (height - 1 - 2 * y);
+        const unsigned char* row1 = row0 - static_cast<size_t>(width) * 3;
+        for (int x = 0; x < w / 2; x++) {
+            const unsigned char* p00 = row0 + x * 6;
+            const unsigned char* p01 = p00 + 3;
+            const unsigned char* p10 = row1 + x * 6;
+            const unsigned char* p11 = p10 + 3;
+            float r = (p00[0] + p01[0] + p10[0] + p11[0]) * 0.25f;
+            float g = (p00[1] + p01[1] + p10[1] + p11[1]) * 0.25f;
+            float b = (p00[2] + p01[2] + p10[2] + p11[2]) * 0.25f;
+            cbPlane[y * (w / 2) + x] = static_cast<unsigned char>(128.0f - 0.168736f * r - 0.331264f * g + 0.5f * b + 0.5f);
+            crPlane[y * (w / 2) + x] = static_cast<unsigned char>(128.0f + 0.5f * r - 0.418688f * g - 0.081312f * b + 0.5f);
+        }
+    }
+
+    fputs("FRAME\n", file);
+    fwrite(planes.data(), 1, planes.size(), file);
+}
+
+// ---------- captura (thread de renderização) ----------
+
+FrameCapture::FrameCapture()
+    : ringIndex(0), usePixelBuffers(false), initialized(false), screenshotRequested(false),
+      screenshotCount(0), recording(false), stopRequested(false), videoWidth(0), videoHeight(0),
+      droppedFrames(0), workerRunning(false) {
+    for (int i = 0; i < PBO_RING_SIZE; i++) {
+        ring[i].kind = FrameKind::None;
+        ring[i].width = ring[i].height = 0;
+        ring[i].buffer = 0;
+        ring[i].bufferSize = 0;
+    }
+    for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+        frames[i].kind = FrameKind::None;
+        freeFrames.Push(&frames[i]);
+    }
+}
+
+FrameCapture::~FrameCapture() {
+    Stop();
+}
+
+// nome base com data e hora, ex: captura_20250101_120000
+static std::string CaptureBaseName() {
+    char name[64];
+    time_t now = time(NULL);
+    strftime(name, sizeof(name), "captura_%Y%m%d_%H%M%S", localtime(&now));
+    return name;
+}
+
+void FrameCapture::RequestScreenshot() {
+    screenshotRequested = true;
+}
+
+void FrameCapture::ToggleRecording() {
+    if (recording) {
+        stopRequested = true;
+        return;
+    }
+    if (stopRequested) return; // o fim da gravação anterior ainda não foi enviado
+
+    videoPath = CaptureBaseName() + ".y4m";
+    videoWidth = videoHeight = 0; // definidos no primeiro quadro
+    droppedFrames = 0;
+    nextVideoFrame = std::chrono::steady_clock::now();
+    recording = true;
+    printf("[captura] gravando %s\n", videoPath.c_str());
+}
+
+bool FrameCapture::HasPendingWork() const {
+    if (recording || screenshotRequested || stopRequested) return true;
+    for (int i = 0; i < PBO_RING_SIZE; i++) {
+        if (ring[i].kind != FrameKind::None) return true;
+    }
+    return false;
+}
+
+void FrameCapture::Initialize() {
+    initialized = true;
+    usePixelBuffers = GLExt::HasBuffers();
+    if (usePixelBuffers) {
+        for (int i = 0; i < PBO_RING_SIZE; i++) {
+            GLExt::GenBuffers(1, &ring[i].buffer);
+        }
+    }
+
+    workerRunning.store(true);
+    worker = std::thread(&FrameCapture::WorkerLoop, this);
+}
+
+void FrameCapture::CaptureFrame(int width, int height) {
+    if (!initialized) {
+        if (!screenshotRequested && !recording) return;
+        Initialize();
+    }
+
+    // a leitura feita há PBO_RING_SIZE quadros já terminou na GPU: copia para um quadro livre
+    PendingRead& slot = ring[ringIndex];
+    if (slot.kind != FrameKind::None && !CollectPending(slot)) {
+        return; // fim de vídeo esperando um quadro livre; tenta de novo no próximo
+    }
+
+    // decide o que ler neste quadro
+    FrameKind kind = FrameKind::None;
+    std::string path;
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    if (recording && !stopRequested && videoWidth != 0 && (width != videoWidth || height != videoHeight)) {
+        printf("[captura] a janela mudou de tamanho, encerrando a gravacao\n");
+        stopRequested = true;
+    }
+
+    if (stopRequested) {
+        kind = FrameKind::VideoEnd;
+        path = videoPath;
+        recording = false;
+        stopRequested = false;
+    } else if (screenshotRequested) {
+        kind = FrameKind::Screenshot;
+        char suffix[32];
+        sprintf(suffix, "_%d.png", ++screenshotCount);
+        path = CaptureBaseName() + suffix;
+        screenshotRequested = false;
+    } else if (recording && now >= nextVideoFrame) {
+        kind = FrameKind::VideoFrame;
+        path = videoPath;
+        if (videoWidth == 0) {
+            videoWidth = width;
+            videoHeight = height;
+        }
+
+        // se o jogo ficou para trás, os quadros pulados contam como descartados
+        std::chrono::steady_clock::duration period =
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / VIDEO_FPS));
+        long late = static_cast<long>((now - nextVideoFrame) / period);
+        droppedFrames += late;
+        nextVideoFrame += period * (late + 1);
+    }
+
+    if (kind != FrameKind::None) {
+        if (usePixelBuffers) {
+            StartRead(slot, kind, width, height, path);
+        } else if (kind == FrameKind::VideoEnd) {
+            if (!Submit(kind, width, height, path, nullptr)) {
+                stopRequested = true; // sem quadro livre, tenta no próximo
+                recording = true;
+            }
+        } else {
+            // sem pixel buffers a leitura é síncrona
+            syncPixels.resize(static_cast<size_t>(width) * height * 3);
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+            glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, syncPixels.data());
+            Submit(kind, width, height, path, syncPixels.data());
+        }
+    }
+
+    ringIndex = (ringIndex + 1) % PBO_RING_SIZE;
+}
+
+void FrameCapture::StartRead(PendingRead& read, FrameKind kind, int width, int height, const std::string& path) {
+    read.kind = kind;
+    read.width = width;
+    read.height = height;
+    read.path = path;
+    if (kind == FrameKind::VideoEnd) return; // só marca a ordem, não lê pixels
+
+    size_t size = static_cast<size_t>(width) * height * 3;
+    GLExt::BindBuffer(GL_PIXEL_PACK_BUFFER, read.buffer);
+    if (read.bufferSize < size) {
+        GLExt::BufferData(GL_PIXEL_PACK_BUFFER, static_cast<ptrdiff_t>(size), nullptr, GL_STREAM_READ);
+        read.bufferSize = size;
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, nullptr); // retorna sem esperar a GPU
+    GLExt::BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+bool FrameCapture::CollectPending(PendingRead& read) {
+    Frame* frame = nullptr;
+    if (!freeFrames.Pop(frame)) {
+        if (read.kind == FrameKind::VideoEnd) return false;
+
+        // a escrita está atrasada: descarta em vez de travar o jogo
+        if (read.kind == FrameKind::VideoFrame) {
+            droppedFrames++;
+        } else {
+            printf("[captura] fila cheia, captura de tela descartada\n");
+        }
+        read.kind = FrameKind::None;
+        return true;
+    }
+
+    frame->kind = read.kind;
+    frame->width = read.width;
+    frame->height = read.height;
+    frame->path = read.path;
+    frame->droppedFrames = droppedFrames;
+
+    if (read.kind != FrameKind::VideoEnd) {
+        size_t size = static_cast<size_t>(read.width) * read.height * 3;
+        frame->pixels.resize(size);
+        GLExt::BindBuffer(GL_PIXEL_PACK_BUFFER, read.buffer);
+        const void* mapped = GLExt::MapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+        if (mapped) {
+            memcpy(frame->pixels.data(), mapped, size);
+            GLExt::UnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        GLExt::BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    encodeQueue.Push(frame); // nunca enche: há no máximo MAX_FRAMES_IN_FLIGHT quadros
+    read.kind = FrameKind::None;
+    return true;
+}
+
+bool FrameCapture::Submit(FrameKind kind, int width, int height, const std::string& path, const unsigned char* pixels) {
+    Frame* frame = nullptr;
+    if (!freeFrames.Pop(frame)) {
+        if (kind == FrameKind::VideoFrame) droppedFrames++;
+        else if (kind == FrameKind::Screenshot) printf("[captura] fila cheia, captura de tela descartada\n");
+        return false;
+    }
+
+    frame->kind = kind;
+    frame->width = width;
+    frame->height = height;
+    frame->path = path;
+    frame->droppedFrames = droppedFrames;
+    if (pixels) {
+        frame->pixels.assign(pixels, pixels + static_cast<size_t>(width) * height * 3);
+    }
+    encodeQueue.Push(frame);
+    return true;
+}
+
+void FrameCapture::Stop() {
+    if (recording) {
+        printf("[captura] gravacao interrompida ao sair: %s\n", videoPath.c_str());
+        recording = false;
+    }
+    workerRunning.store(false);
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+// ---------- thread de escrita ----------
+
+void FrameCapture::WorkerLoop() {
+    FILE* video = nullptr;
+    std::string currentVideo;
+    int videoFrames = 0;
+    std::vector<unsigned char> planes;
+
+    while (true) {
+        Frame* frame = nullptr;
+        if (!encodeQueue.Pop(frame)) {
+            if (!workerRunning.load()) break; // fila vazia e pedido de parada
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            continue;
+        }
+
+        switch (frame->kind) {
+            case FrameKind::Screenshot:
+                if (WritePng(frame->path, frame->pixels.data(), frame->width, frame->height)) {
+                    printf("[captura] tela salva em %s\n", frame->path.c_str());
+                } else {
+                    printf("[captura] erro ao salvar %s\n", frame->path.c_str());
+                }
+                break;
+
+            case FrameKind::VideoFrame:
+                if (!video || currentVideo != frame->path) {
+                    if (video) fclose(video);
+                    currentVideo = frame->path;
+                    videoFrames = 0;
+                    video = fopen(currentVideo.c_str(), "wb");
+                    if (video) {
+                        fprintf(video, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n",
+                                frame->width & ~1, frame->height & ~1, VIDEO_FPS);
+                    } else {
+                        printf("[captura] erro ao criar %s\n", currentVideo.c_str());
+                    }
+                }
+                if (video) {
+                    WriteY4mFrame(video, frame->pixels.data(), frame->width, frame->height, planes);
+                    videoFrames++;
+                }
+                break;
+
+            case FrameKind::VideoEnd:
+                if (video && currentVideo == frame->path) {
+                    fclose(video);
+                    video = nullptr;
+                    printf("[captura] video salvo em %s (%d quadros, %d descartados)\n",
+                           currentVideo.c_str(), videoFrames, frame->droppedFrames);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        freeFrames.Push(frame);
+    }
+
+    if (video) fclose(video);
+}
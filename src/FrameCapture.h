@@ -0,0 +1,104 @@
+/**
+ * FrameCapture.h
+ * Captura de capturas de tela (PNG) e de vídeo (Y4M) feita pelo próprio jogo.
+ * A tela é lida para um anel de pixel buffers, então a CPU só mapeia um
+ * buffer alguns quadros depois, quando a GPU já terminou de copiar.
+ * A codificação e a escrita no disco ficam numa thread separada.
+ */
+
+#ifndef __FRAME_CAPTURE_H__
+#define __FRAME_CAPTURE_H__
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SpscQueue.h"
+
+class FrameCapture {
+public:
+    static const int PBO_RING_SIZE = 3;       // quadros entre pedir a leitura e mapear o buffer
+    static const int MAX_FRAMES_IN_FLIGHT = 8; // quadros esperando a codificação; além disso descarta
+    static const int VIDEO_FPS = 30;
+
+    FrameCapture();
+    ~FrameCapture();
+
+    // pedidos feitos pelo teclado (thread de renderização)
+    void RequestScreenshot();
+    void ToggleRecording();
+
+    bool IsRecording() const { return recording; }
+    int GetDroppedFrames() const { return droppedFrames; }
+
+    // há pedido ou leitura no anel ainda sem terminar: precisa de mais quadros para ir ao disco
+    bool HasPendingWork() const;
+
+    // chamado no fim de cada quadro, antes da troca de buffers (thread de renderização)
+    void CaptureFrame(int width, int height);
+
+    // espera a thread de escrita terminar o que já está na fila
+    void Stop();
+
+private:
+    enum class FrameKind {
+        None,
+        Screenshot,
+        VideoFrame,
+        VideoEnd
+    };
+
+    // quadro lido da tela (linhas de baixo para cima, RGB)
+    struct Frame {
+        FrameKind kind;
+        int width;
+        int height;
+        int droppedFrames;   // em VideoEnd: quadros descartados na gravação
+        std::string path;
+        std::vector<unsigned char> pixels;
+    };
+
+    // leitura pendente num pixel buffer
+    struct PendingRead {
+        FrameKind kind;
+        int width;
+        int height;
+        std::string path;
+        unsigned int buffer;
+        size_t bufferSize;
+    };
+
+    Frame frames[MAX_FRAMES_IN_FLIGHT];
+    SpscQueue<Frame*, 16> freeFrames;    // escrita -> renderização
+    SpscQueue<Frame*, 16> encodeQueue;   // renderização -> escrita
+
+    PendingRead ring[PBO_RING_SIZE];
+    std::vector<unsigned char> syncPixels; // leitura direta quando não há pixel buffers
+    int ringIndex;
+    bool usePixelBuffers;
+    bool initialized;
+
+    bool screenshotRequested;
+    int screenshotCount;
+    bool recording;
+    bool stopRequested;
+    std::string videoPath;
+    int videoWidth, videoHeight;
+    int droppedFrames;
+    std::chrono::steady_clock::time_point nextVideoFrame;
+
+    std::thread worker;
+    std::atomic<bool> workerRunning;
+
+    void Initialize();
+    bool CollectPending(PendingRead& read);
+    void StartRead(PendingRead& read, FrameKind kind, int width, int height, const std::string& path);
+    bool Submit(FrameKind kind, int width, int height, const std::string& path, const unsigned char* pixels);
+
+    // thread de escrita
+    void WorkerLoop();
+};
+
+#endif
@@ -0,0 +1,138 @@
+/**
+ * GLExtensions.cpp
+ * Implementa o carregamento das funções de shader e a compilação dos programas.
+ */
+
+#include "GLExtensions.h"
+#include <cstdio>
+#include <vector>
+
+GLExt::GenBuffersProc GLExt::GenBuffers = nullptr;
+GLExt::DeleteBuffersProc GLExt::DeleteBuffers = nullptr;
+GLExt::BindBufferProc GLExt::BindBuffer = nullptr;
+GLExt::BufferDataProc GLExt::BufferData = nullptr;
+GLExt::MapBufferProc GLExt::MapBuffer = nullptr;
+GLExt::UnmapBufferProc GLExt::UnmapBuffer = nullptr;
+
+GLExt::CreateShaderProc GLExt::CreateShader = nullptr;
+GLExt::ShaderSourceProc GLExt::ShaderSource = nullptr;
+GLExt::CompileShaderProc GLExt::CompileShader = nullptr;
+GLExt::GetShaderivProc GLExt::GetShaderiv = nullptr;
+GLExt::GetShaderInfoLogProc GLExt::GetShaderInfoLog = nullptr;
+GLExt::DeleteShaderProc GLExt::DeleteShader = nullptr;
+GLExt::CreateProgramProc GLExt::CreateProgram = nullptr;
+GLExt::AttachShaderProc GLExt::AttachShader = nullptr;
+GLExt::LinkProgramProc GLExt::LinkProgram = nullptr;
+GLExt::GetProgramivProc GLExt::GetProgramiv = nullptr;
+GLExt::GetProgramInfoLogProc GLExt::GetProgramInfoLog = nullptr;
+GLExt::UseProgramProc GLExt::UseProgram = nullptr;
+GLExt::GetUniformLocationProc GLExt::GetUniformLocation = nullptr;
+GLExt::Uniform1fProc GLExt::Uniform1f = nullptr;
+GLExt::Uniform2fProc GLExt::Uniform2f = nullptr;
+GLExt::Uniform2fvProc GLExt::Uniform2fv = nullptr;
+
+template <typename Proc>
+static bool LoadProc(Proc& proc, const char* name) {
+    proc = reinterpret_cast<Proc>(glutGetProcAddress(name));
+    return proc != nullptr;
+}
+
+bool GLExt::HasShaders() {
+    static int loaded = -1; // -1 = ainda não tentou
+    if (loaded >= 0) return loaded == 1;
+
+    bool ok = true;
+    ok &= LoadProc(CreateShader, "glCreateShader");
+    ok &= LoadProc(ShaderSource, "glShaderSource");
+    ok &= LoadProc(CompileShader, "glCompileShader");
+    ok &= LoadProc(GetShaderiv, "glGetShaderiv");
+    ok &= LoadProc(GetShaderInfoLog, "glGetShaderInfoLog");
+    ok &= LoadProc(DeleteShader, "glDeleteShader");
+    ok &= LoadProc(CreateProgram, "glCreateProgram");
+    ok &= LoadProc(AttachShader, "glAttachShader");
+    ok &= LoadProc(LinkProgram, "glLinkProgram");
+    ok &= LoadProc(GetProgramiv, "glGetProgramiv");
+    ok &= LoadProc(GetProgramInfoLog, "glGetProgramInfoLog");
+    ok &= LoadProc(UseProgram, "glUseProgram");
+    ok &= LoadProc(GetUniformLocation, "glGetUniformLocation");
+    ok &= LoadProc(Uniform1f, "glUniform1f");
+    ok &= LoadProc(Uniform2f, "glUniform2f");
+    ok &= LoadProc(Uniform2fv, "glUniform2fv");
+
+    if (!ok) {
+        printf("[gl] funcoes de shader (OpenGL 2.0) indisponiveis, usando desenho fixo\n");
+    }
+    loaded = ok ? 1 : 0;
+    return ok;
+}
+
+bool GLExt::HasBuffers() {
+    static int loaded = -1; // -1 = ainda não tentou
+    if (loaded >= 0) return loaded == 1;
+
+    bool ok = true;
+    ok &= LoadProc(GenBuffers, "glGenBuffers");
+    ok &= LoadProc(DeleteBuffers, "glDeleteBuffers");
+    ok &= LoadProc(BindBuffer, "glBindBuffer");
+    ok &= LoadProc(BufferData, "glBufferData");
+    ok &= LoadProc(MapBuffer, "glMapBuffer");
+    ok &= LoadProc(UnmapBuffer, "glUnmapBuffer");
+
+    if (!ok) {
+        printf("[gl] buffer objects (OpenGL 1.5) indisponiveis, usando leitura direta da tela\n");
+    }
+    loaded = ok ? 1 : 0;
+    return ok;
+}
+
+GLuint GLExt::CompileShaderSource(GLenum type, const char* source) {
+    GLuint shader = CreateShader(type);
+    ShaderSource(shader, 1, &source, nullptr);
+    CompileShader(shader);
+
+    GLint status = 0;
+    GetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (!status) {
+        GLint length = 0;
+        GetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> log(length > 1 ? length : 1, '\0');
+        GetShaderInfoLog(shader, static_cast<GLsizei>(log.size()), nullptr, log.data());
+        printf("[gl] erro ao compilar shader:\n%s\n", log.data());
+        DeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+GLuint GLExt::BuildProgram(const char* vertexSource, const char* fragmentSource) {
+    if (!HasShaders()) return 0;
+
+    GLuint vertex = CompileShaderSource(GL_VERTEX_SHADER, vertexSource);
+    GLuint fragment = CompileShaderSource(GL_FRAGMENT_SHADER, fragmentSource);
+    if (!vertex || !fragment) {
+        if (vertex) DeleteShader(vertex);
+        if (fragment) DeleteShader(fragment);
+        return 0;
+    }
+
+    GLuint program = CreateProgram();
+    AttachShader(program, vertex);
+    AttachShader(program, fragment);
+    LinkProgram(program);
+
+    // o programa mantém os shaders enquanto existir
+    DeleteShader(vertex);
+    DeleteShader(fragment);
+
+    GLint status = 0;
+    GetProgramiv(program, GL_LINK_STATUS, &status);
+    if (!status) {
+        GLint length = 0;
+        GetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> log(length > 1 ? length : 1, '\0');
+        GetProgramInfoLog(program, static_cast<GLsizei>(log.size()), nullptr, log.data());
+        printf("[gl] erro ao ligar programa:\n%s\n", log.data());
+        return 0;
+    }
+    return program;
+}
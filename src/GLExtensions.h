@@ -0,0 +1,97 @@
+/**
+ * GLExtensions.h
+ * Carrega em tempo de execução as funções de shader (OpenGL 2.0) e de
+ * buffer objects (OpenGL 1.5), que não existem no opengl32 do Windows (OpenGL 1.1).
+ * Os ponteiros são obtidos com glutGetProcAddress depois que a janela existe.
+ */
+
+#ifndef __GL_EXTENSIONS_H__
+#define __GL_EXTENSIONS_H__
+
+#include <cstddef>
+#include <GL/glut.h>
+#include <GL/freeglut_ext.h>
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+#ifndef GL_PIXEL_PACK_BUFFER
+#define GL_PIXEL_PACK_BUFFER 0x88EB
+#define GL_STREAM_READ       0x88E1
+#define GL_READ_ONLY         0x88B8
+#endif
+
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#define GL_VERTEX_SHADER   0x8B31
+#define GL_COMPILE_STATUS  0x8B81
+#define GL_LINK_STATUS     0x8B82
+#define GL_INFO_LOG_LENGTH 0x8B84
+#endif
+
+class GLExt {
+public:
+    typedef void      (APIENTRY *GenBuffersProc)(GLsizei n, GLuint* buffers);
+    typedef void      (APIENTRY *DeleteBuffersProc)(GLsizei n, const GLuint* buffers);
+    typedef void      (APIENTRY *BindBufferProc)(GLenum target, GLuint buffer);
+    typedef void      (APIENTRY *BufferDataProc)(GLenum target, ptrdiff_t size, const void* data, GLenum usage);
+    typedef void*     (APIENTRY *MapBufferProc)(GLenum target, GLenum access);
+    typedef GLboolean (APIENTRY *UnmapBufferProc)(GLenum target);
+
+    typedef GLuint (APIENTRY *CreateShaderProc)(GLenum type);
+    typedef void   (APIENTRY *ShaderSourceProc)(GLuint shader, GLsizei count, const char* const* source, const GLint* length);
+    typedef void   (APIENTRY *CompileShaderProc)(GLuint shader);
+    typedef void   (APIENTRY *GetShaderivProc)(GLuint shader, GLenum pname, GLint* params);
+    typedef void   (APIENTRY *GetShaderInfoLogProc)(GLuint shader, GLsizei maxLength, GLsizei* length, char* infoLog);
+    typedef void   (APIENTRY *DeleteShaderProc)(GLuint shader);
+    typedef GLuint (APIENTRY *CreateProgramProc)(void);
+    typedef void   (APIENTRY *AttachShaderProc)(GLuint program, GLuint shader);
+    typedef void   (APIENTRY *LinkProgramProc)(GLuint program);
+    typedef void   (APIENTRY *GetProgramivProc)(GLuint program, GLenum pname, GLint* params);
+    typedef void   (APIENTRY *GetProgramInfoLogProc)(GLuint program, GLsizei maxLength, GLsizei* length, char* infoLog);
+    typedef void   (APIENTRY *UseProgramProc)(GLuint program);
+    typedef GLint  (APIENTRY *GetUniformLocationProc)(GLuint program, const char* name);
+    typedef void   (APIENTRY *Uniform1fProc)(GLint location, GLfloat v0);
+    typedef void   (APIENTRY *Uniform2fProc)(GLint location, GLfloat v0, GLfloat v1);
+    typedef void   (APIENTRY *Uniform2fvProc)(GLint location, GLsizei count, const GLfloat* value);
+
+    static GenBuffersProc GenBuffers;
+    static DeleteBuffersProc DeleteBuffers;
+    static BindBufferProc BindBuffer;
+    static BufferDataProc BufferData;
+    static MapBufferProc MapBuffer;
+    static UnmapBufferProc UnmapBuffer;
+
+    static CreateShaderProc CreateShader;
+    static ShaderSourceProc ShaderSource;
+    static CompileShaderProc CompileShader;
+    static GetShaderivProc GetShaderiv;
+    static GetShaderInfoLogProc GetShaderInfoLog;
+    static DeleteShaderProc DeleteShader;
+    static CreateProgramProc CreateProgram;
+    static AttachShaderProc AttachShader;
+    static LinkProgramProc LinkProgram;
+    static GetProgramivProc GetProgramiv;
+    static GetProgramInfoLogProc GetProgramInfoLog;
+    static UseProgramProc UseProgram;
+    static GetUniformLocationProc GetUniformLocation;
+    static Uniform1fProc Uniform1f;
+    static Uniform2fProc Uniform2f;
+    static Uniform2fvProc Uniform2fv;
+
+    // carrega os ponteiros na primeira chamada (precisa de um contexto ativo).
+    // retorna true se todas as funções de shader existem
+    static bool HasShaders();
+
+    // buffer objects do OpenGL 1.5 (usados como pixel buffers para leitura assíncrona da tela)
+    static bool HasBuffers();
+
+    // compila e liga um programa GLSL; retorna 0 e imprime o log em caso de erro
+    static GLuint BuildProgram(const char* vertexSource, const char* fragmentSource);
+
+private:
+    static GLuint CompileShaderSource(GLenum type, const char* source);
+};
+
+#endif
@@ -0,0 +1,86 @@
+/**
+ * GameClock.h
+ * Relógio do jogo com passo de simulação fixo.
+ * Acumula o tempo real medido por um relógio de alta resolução e
+ * informa quantos passos de simulação devem rodar em cada quadro,
+ * além do fator de interpolação usado pela renderização.
+ */
+
+#ifndef __GAME_CLOCK_H__
+#define __GAME_CLOCK_H__
+
+#include <chrono>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+class FixedTimestep {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    // passo da simulação em segundos (todas as constantes do jogo são por passo)
+    float stepSeconds;
+
+    // limita o tempo de um quadro para não entrar em espiral quando o jogo trava
+    float maxFrameSeconds;
+
+    FixedTimestep(float step = 1.0f / 60.0f, float maxFrame = 0.25f)
+        : stepSeconds(step), maxFrameSeconds(maxFrame), accumulator(0.0f), started(false) {}
+
+    // mede o tempo desde o último quadro e retorna quantos passos fixos devem ser simulados
+    int Advance() {
+        Clock::time_point now = Clock::now();
+        if (!started) {
+            lastTime = now;
+            started = true;
+        }
+
+        float frameSeconds = std::chrono::duration<float>(now - lastTime).count();
+        lastTime = now;
+        if (frameSeconds > maxFrameSeconds) {
+            frameSeconds = maxFrameSeconds;
+        }
+
+        accumulator += frameSeconds;
+
+        int steps = 0;
+        while (accumulator >= stepSeconds) {
+            accumulator -= stepSeconds;
+            steps++;
+        }
+        return steps;
+    }
+
+    // fração do próximo passo já decorrida (0 a 1), usada para interpolar a renderização
+    float GetAlpha() const {
+        return accumulator / stepSeconds;
+    }
+
+    // tempo restante até completar o próximo passo, medido no último Advance()
+    float SecondsUntilNextStep() const {
+        return stepSeconds - accumulator;
+    }
+
+    // descarta o tempo acumulado (ex: ao sair do modo editor)
+    void Reset() {
+        accumulator = 0.0f;
+        started = false;
+    }
+
+private:
+    float accumulator;
+    bool started;
+    Clock::time_point lastTime;
+};
+
+// interpola dois ângulos em radianos pelo caminho mais curto
+inline float InterpolateAngle(float from, float to, float alpha) {
+    float diff = to - from;
+    while (diff > M_PI) diff -= 2 * M_PI;
+    while (diff < -M_PI) diff += 2 * M_PI;
+    return from + diff * alpha;
+}
+
+#endif
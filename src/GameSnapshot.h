@@ -0,0 +1,50 @@
+/**
+ * GameSnapshot.h
+ * Cópia imutável do estado do jogo publicada pela thread de simulação.
+ * A thread de renderização desenha somente a partir destes snapshots,
+ * sem acessar os objetos que a simulação está alterando.
+ */
+
+#ifndef __GAME_SNAPSHOT_H__
+#define __GAME_SNAPSHOT_H__
+
+#include <memory>
+#include <vector>
+
+#include "Tanque.h"
+#include "Target.h"
+#include "ProjectileSystem.h"
+#include "ExplosionManager.h"
+#include "PowerUp.h"
+#include "BSplineTrack.h"
+#include "GameClock.h"
+#include "Camera.h"
+
+struct GameSnapshot {
+    std::vector<Tanque> tanks; // um por jogador ativo
+    TargetSet targets;
+    ProjectileSystem projectiles; // tamanho fixo: a cópia não aloca
+    ExplosionManager explosions;  // a cópia só leva as partículas vivas
+    PowerUp powerUp;
+    LaserEffect laser;
+
+    // a pista só é copiada quando muda; snapshots seguidos compartilham a mesma cópia
+    std::shared_ptr<const BSplineTrack> track;
+
+    PowerUpType storedPowerUp;
+    int playerScore;
+    int gameLevel;
+    int destroyedTargets;
+    bool editorMode;
+    Camera camera; // câmera do modo atual (no jogo o centro e a área são refeitos para cada jogador)
+
+    // instante em que o último passo terminou, usado para interpolar até o próximo
+    FixedTimestep::Clock::time_point stepTime;
+    float stepSeconds;
+
+    GameSnapshot()
+        : storedPowerUp(PowerUpType::None), playerScore(0), gameLevel(1),
+          destroyedTargets(0), editorMode(false), stepSeconds(1.0f / 60.0f) {}
+};
+
+#endif
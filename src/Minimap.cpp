@@ -0,0 +1,113 @@
+/**
+ * Minimap.cpp
+ * Implementa o cache da pista em textura e a composição do minimapa.
+ */
+
+#include "Minimap.h"
+#include "BSplineTrack.h"
+#include "GameSnapshot.h"
+#include "gl_canvas2d.h"
+#include <algorithm>
+
+static const float MAP_PADDING = 0.05f; // borda livre em volta da pista, fração da textura
+
+Minimap::Minimap(float screenSize, float screenMargin)
+    : size(screenSize), margin(screenMargin), texture(0), trackRevision(0), valid(false),
+      scale(1.0f), offset(0, 0) {}
+
+void Minimap::Update(const BSplineTrack& track, float detail, int screenWidth, int screenHeight) {
+    if (valid && track.revision == trackRevision) return;
+
+    // a textura é desenhada no canto da janela, que precisa ser grande o bastante
+    if (screenWidth < TEXTURE_SIZE || screenHeight < TEXTURE_SIZE) return;
+
+    const TrackGeometry& geo = track.GetGeometry(detail);
+
+    // limites da pista a partir das caixas dos trechos das bordas
+    Vector2 boundsMin(FLT_MAX, FLT_MAX), boundsMax(-FLT_MAX, -FLT_MAX);
+    const std::vector<TrackChunk>* sides[2] = { &geo.outlineChunksLeft, &geo.outlineChunksRight };
+    for (const std::vector<TrackChunk>* chunks : sides) {
+        for (const TrackChunk& chunk : *chunks) {
+            boundsMin.set(std::min(boundsMin.x, chunk.boundsMin.x), std::min(boundsMin.y, chunk.boundsMin.y));
+            boundsMax.set(std::max(boundsMax.x, chunk.boundsMax.x), std::max(boundsMax.y, chunk.boundsMax.y));
+        }
+    }
+    if (boundsMin.x > boundsMax.x) {
+        // pista ainda sem curvas completas
+        boundsMin.set(0, 0);
+        boundsMax.set(1, 1);
+    }
+
+    // encaixa a pista na textura mantendo a proporção e centralizando
+    float extent = std::max(std::max(boundsMax.x - boundsMin.x, boundsMax.y - boundsMin.y), 1.0f);
+    scale = TEXTURE_SIZE * (1.0f - 2.0f * MAP_PADDING) / extent;
+    offset.set((TEXTURE_SIZE - (boundsMax.x - boundsMin.x) * scale) * 0.5f - boundsMin.x * scale,
+               (TEXTURE_SIZE - (boundsMax.y - boundsMin.y) * scale) * 0.5f - boundsMin.y * scale);
+
+    CV::beginTextureRender(TEXTURE_SIZE, TEXTURE_SIZE);
+    CV::color(0.15f, 0.15f, 0.2f);
+    CV::rectFill(0, 0, TEXTURE_SIZE, TEXTURE_SIZE);
+    CV::transform(offset.x, offset.y, scale);
+    track.Render(false, detail);
+    CV::endTextureRender(texture, TEXTURE_SIZE, TEXTURE_SIZE);
+
+    trackRevision = track.revision;
+    valid = true;
+}
+
+Vector2 Minimap::ToScreen(const Vector2& world, float x0, float y0) const {
+    float toScreen = size / TEXTURE_SIZE;
+    return Vector2(x0 + (world.x * scale + offset.x) * toScreen,
+                   y0 + (world.y * scale + offset.y) * toScreen);
+}
+
+void Minimap::Render(const GameSnapshot& snapshot, float alpha, const Camera* views, int numViews,
+                     int screenWidth, int screenHeight) const {
+    if (!valid) return;
+
+    // janela pequena demais para o minimapa no canto
+    if (screenWidth < size + margin || screenHeight < size + margin) return;
+
+    // canto superior direito
+    float x0 = screenWidth - size - margin;
+    float y0 = margin;
+
+    CV::translate(0, 0);
+    CV::texturedRect(texture, x0, y0, x0 + size, y0 + size);
+    CV::color(1.0f, 1.0f, 1.0f);
+    CV::rect(x0, y0, x0 + size, y0 + size);
+
+    // área que aparece na tela de cada jogador
+    CV::color(0.8f, 0.8f, 0.8f);
+    for (int v = 0; v < numViews; v++) {
+        Vector2 viewMin, viewMax;
+        views[v].GetVisibleBounds(viewMin, viewMax);
+        Vector2 rectMin = ToScreen(viewMin, x0, y0);
+        Vector2 rectMax = ToScreen(viewMax, x0, y0);
+        CV::rect(std::max(rectMin.x, x0), std::max(rectMin.y, y0),
+                 std::min(rectMax.x, x0 + size), std::min(rectMax.y, y0 + size));
+    }
+
+    // marcadores
+    const float markerSize = 2.0f;
+    CV::color(1.0f, 0.2f, 0.2f);
+    snapshot.targets.ForEach([&](int, const TargetBody& target) {
+        if (!target.active) return;
+        Vector2 p = ToScreen(target.position, x0, y0);
+        CV::rectFill(p.x - markerSize, p.y - markerSize, p.x + markerSize, p.y + markerSize);
+    });
+
+    if (snapshot.powerUp.active) {
+        Vector2 p = ToScreen(snapshot.powerUp.position, x0, y0);
+        CV::color(0.2f, 0.8f, 1.0f);
+        CV::rectFill(p.x - markerSize, p.y - markerSize, p.x + markerSize, p.y + markerSize);
+    }
+
+    // tanques na cor de cada jogador
+    const float tankMarkerSize = markerSize * 1.5f;
+    for (const Tanque& tank : snapshot.tanks) {
+        Vector2 p = ToScreen(tank.GetRenderPosition(alpha), x0, y0);
+        CV::color(tank.bodyColorR * 1.5f, tank.bodyColorG * 1.5f, tank.bodyColorB * 1.5f);
+        CV::rectFill(p.x - tankMarkerSize, p.y - tankMarkerSize, p.x + tankMarkerSize, p.y + tankMarkerSize);
+    }
+}
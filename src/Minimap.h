@@ -0,0 +1,47 @@
+/**
+ * Minimap.h
+ * Minimapa exibido no canto da tela durante o jogo.
+ * A pista é desenhada uma única vez numa textura pequena sempre que é
+ * editada; a cada quadro só a textura e os marcadores são desenhados.
+ */
+
+#ifndef __MINIMAP_H__
+#define __MINIMAP_H__
+
+#include "Vector2.h"
+
+class BSplineTrack;
+class Camera;
+struct GameSnapshot;
+
+class Minimap {
+public:
+    static const int TEXTURE_SIZE = 256; // lado da textura (potência de 2)
+
+    float size;    // lado do minimapa na tela em pixels
+    float margin;  // distância até a borda da tela
+
+    Minimap(float screenSize = 180.0f, float screenMargin = 10.0f);
+
+    // redesenha a textura se a pista mudou. deve ser chamado antes de limpar a tela,
+    // pois usa o canto da janela como área de desenho
+    void Update(const BSplineTrack& track, float detail, int screenWidth, int screenHeight);
+
+    // desenha a textura e os marcadores (tanques, inimigos, power-up e a área visível de cada câmera).
+    // não desenha nada se a janela não comporta o minimapa
+    void Render(const GameSnapshot& snapshot, float alpha, const Camera* views, int numViews,
+                int screenWidth, int screenHeight) const;
+
+private:
+    unsigned int texture;
+    unsigned int trackRevision; // revisão da pista desenhada na textura
+    bool valid;
+
+    // mundo -> pixels da textura: p * scale + offset
+    float scale;
+    Vector2 offset;
+
+    Vector2 ToScreen(const Vector2& world, float x0, float y0) const;
+};
+
+#endif
@@ -8,13 +8,13 @@
 #include "PowerUp.h"
 #include "Tanque.h"
 #include "Target.h"
+#include "ExplosionManager.h"
+#include "BSplineTrack.h"
+#include "CommandBuffer.h"
 #include <cmath>
 
 // inicializa membros estáticos
-bool PowerUp::laserActive = false;
-int PowerUp::laserDuration = 0;
-Vector2 PowerUp::laserStart = Vector2(0, 0);
-Vector2 PowerUp::laserEnd = Vector2(0, 0);
+LaserEffect PowerUp::laser;
 
 PowerUp::PowerUp() 
     : position(0, 0), active(false), type(PowerUpType::None), radius(15.0f), animationAngle(0.0f) {}
@@ -155,7 +155,8 @@ bool PowerUp::ApplyShieldEffect(Tanque* tank) {
     return true;
 }
 
-int PowerUp::ApplyLaserEffect(Tanque* tank, std::vector<Target>& targets) {
+int PowerUp::ApplyLaserEffect(Tanque* tank, TargetSet& targets, ExplosionManager& explosions, const BSplineTrack* track,
+                               CommandBuffer& commands) {
     if (!tank) return 0;
     
     // calcula a direção do laser baseado no ângulo da torre do tanque
@@ -166,16 +167,27 @@ int PowerUp::ApplyLaserEffect(Tanque* tank, std::vector<Target>& targets) {
     // define o alcance do laser (muito longe)
     const float LASER_RANGE = 2000.0f; 
     Vector2 laserEnd = laserStart + laserDir * LASER_RANGE;
+
+    // o feixe para na primeira parede da pista
+    float laserRange = LASER_RANGE;
+    if (track) {
+        RayQuery beam(laserStart, laserEnd);
+        if (track->rayCast(beam)) {
+            laserEnd = beam.HitPoint();
+            laserRange = LASER_RANGE * beam.time;
+        }
+    }
     
     // configura as propriedades do efeito de laser estático para renderização em múltiplos frames
-    PowerUp::laserActive = true;
-    PowerUp::laserDuration = LASER_MAX_DURATION;
-    PowerUp::laserStart = laserStart;
-    PowerUp::laserEnd = laserEnd;
+    PowerUp::laser.active = true;
+    PowerUp::laser.duration = LASER_MAX_DURATION;
+    SimulationTimers().Restart(PowerUp::laser.timer, LASER_MAX_DURATION, &PowerUp::OnLaserEnd);
+    PowerUp::laser.start = laserStart;
+    PowerUp::laser.end = laserEnd;
     
     // verifica cada alvo para colisão com o feixe de laser
-    for (auto& target : targets) {
-        if (!target.active) continue;
+    targets.ForEach([&](int id, TargetBody& target) {
+        if (!target.active) return;
         
         // teste simples de intersecção círculo-linha
         Vector2 targetToLaserStart = laserStart - target.position;
@@ -184,10 +196,10 @@ int PowerUp::ApplyLaserEffect(Tanque* tank, std::vector<Target>& targets) {
         float t = -(targetToLaserStart.x * laserDir.x + targetToLaserStart.y * laserDir.y);
         
         // se a projeção for negativa, o laser começa após o alvo
-        if (t < 0) continue;
+        if (t < 0) return;
         
-        // se a projeção for maior que LASER_RANGE, o alvo está além do alcance do laser
-        if (t > LASER_RANGE) continue;
+        // se a projeção passar do fim do feixe, o alvo está além do alcance ou atrás da parede
+        if (t > laserRange) return;
         
         // calcula o ponto mais próximo na linha do laser ao centro do alvo
         Vector2 closestPoint = laserStart + laserDir * t;
@@ -196,34 +208,39 @@ int PowerUp::ApplyLaserEffect(Tanque* tank, std::vector<Target>& targets) {
         if ((closestPoint - target.position).lengthSq() <= target.radius * target.radius) {
             // alvo é atingido pelo laser - morte instantânea
             target.active = false;
+            commands.DestroyTarget(id);
             targetsDestroyed++;
             
             // cria uma explosão na posição do alvo quando atingido pelo laser
             if (tank) {  // corrigido: apenas verifica se o tanque é válido
                 Vector2 explosionDir = (target.position - laserStart).normalized();
-                tank->explosions.CreateExplosion(target.position, explosionDir, 30);
+                explosions.CreateExplosion(target.position, explosionDir, 30);
             }
         }
-    }
+    });
     
     return targetsDestroyed;
 }
 
-void PowerUp::UpdateLaserEffect() {
-    // decrementa a duração se o laser estiver ativo
-    if (laserActive) {
-        laserDuration--;
-        if (laserDuration <= 0) {
-            laserActive = false;
-        }
+void PowerUp::OnLaserEnd(void*, int) {
+    laser.active = false;
+    laser.duration = 0;
+}
+
+void PowerUp::RefreshLaserCountdown() {
+    if (laser.active) {
+        laser.duration = SimulationTimers().Remaining(laser.timer);
     }
 }
 
-void PowerUp::RenderLaserEffect() {
-    if (!laserActive) return;
+void PowerUp::RenderLaserEffect(const LaserEffect& effect) {
+    if (!effect.active) return;
+
+    Vector2 laserStart = effect.start;
+    Vector2 laserEnd = effect.end;
     
     // calcula alpha para efeito de fade-out
-    float alpha = static_cast<float>(laserDuration) / LASER_MAX_DURATION;
+    float alpha = static_cast<float>(effect.duration) / LASER_MAX_DURATION;
     
     // desenha o feixe de laser com espessura crescente para melhor visibilidade
     float thickness = 6.0f * alpha; // mais grosso no início, mais fino conforme desaparece
@@ -10,13 +10,16 @@
 
 #include "Vector2.h"
 #include "gl_canvas2d.h"
+#include "TimerWheel.h"
 #include <cmath>
 #include <vector> 
 
 // declarações antecipadas
 class BSplineTrack;
+class CommandBuffer;
 class Tanque;
-class Target;
+class ExplosionManager;
+class TargetSet;
 
 // tipos de power-ups
 enum class PowerUpType {
@@ -26,6 +29,17 @@ enum class PowerUpType {
     Laser = 3       // "X" azul - destrói inimigos em linha
 };
 
+// estado do feixe de laser ativo (copiado para os snapshots da renderização)
+struct LaserEffect {
+    bool active;
+    TimerHandle timer;  // ao vencer, o feixe se apaga
+    int duration;       // o que falta, para o fade do desenho
+    Vector2 start;
+    Vector2 end;
+
+    LaserEffect() : active(false), duration(0), start(0, 0), end(0, 0) {}
+};
+
 class PowerUp {
 public:
     Vector2 position;
@@ -35,10 +49,7 @@ public:
     float animationAngle;
     
     // propriedades do efeito laser
-    static bool laserActive;
-    static int laserDuration;
-    static Vector2 laserStart;
-    static Vector2 laserEnd;
+    static LaserEffect laser;
     static const int LASER_MAX_DURATION = 45; // laser dura 45 quadros (3/4 segundo a 60fps)
     
     PowerUp();
@@ -56,11 +67,16 @@ public:
     // aplica efeitos de power-up
     static void ApplyHealthEffect(Tanque* tank);
     static bool ApplyShieldEffect(Tanque* tank); // retorna se o escudo foi aplicado
-    static int ApplyLaserEffect(Tanque* tank, std::vector<Target>& targets); // correção: corresponder assinatura com implementação
+    // o feixe é cortado pela primeira parede da pista; os alvos atingidos são registrados em commands
+    static int ApplyLaserEffect(Tanque* tank, TargetSet& targets, ExplosionManager& explosions, const BSplineTrack* track,
+                                CommandBuffer& commands); // correção: corresponder assinatura com implementação
     
-    // atualiza e renderiza o efeito do laser
-    static void UpdateLaserEffect();
-    static void RenderLaserEffect();
+    // copia o que falta do laser para o fade; renderiza o efeito do laser
+    static void RefreshLaserCountdown();
+    static void RenderLaserEffect(const LaserEffect& effect);
+
+private:
+    static void OnLaserEnd(void*, int);
 };
 
 #endif
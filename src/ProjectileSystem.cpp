@@ -0,0 +1,174 @@
+/**
+ * ProjectileSystem.cpp
+ * Implementa a criação, o movimento, a colisão com a pista e o desenho
+ * de todos os projéteis a partir dos vetores de tamanho fixo.
+ */
+
+#include "ProjectileSystem.h"
+#include "BSplineTrack.h"
+#include "Camera.h"
+#include "DecalLayer.h"
+#include "ExplosionManager.h"
+#include "gl_canvas2d.h"
+#include <cmath>
+#include <algorithm>
+
+ProjectileSystem::ProjectileSystem() : freeCount(0), usedSlots(0) {
+    // zera também os slots nunca usados, que o laço com SSE pode ler
+    std::fill(posX, posX + CAPACITY, 0.0f);
+    std::fill(posY, posY + CAPACITY, 0.0f);
+    std::fill(prevX, prevX + CAPACITY, 0.0f);
+    std::fill(prevY, prevY + CAPACITY, 0.0f);
+    std::fill(velX, velX + CAPACITY, 0.0f);
+    std::fill(velY, velY + CAPACITY, 0.0f);
+    for (int i = 0; i < CAPACITY; i++) {
+        active[i] = false;
+    }
+}
+
+int ProjectileSystem::Spawn(ProjectileTeam projectileTeam, int projectileOwner, const Vector2& position,
+                            const Vector2& velocity, float collisionRadius, int steps) {
+    int slot;
+    if (freeCount > 0) {
+        slot = freeSlots[--freeCount];
+    } else if (usedSlots < CAPACITY) {
+        slot = usedSlots++;
+    } else {
+        return -1; // cheio, o tiro é descartado
+    }
+
+    posX[slot] = prevX[slot] = position.x;
+    posY[slot] = prevY[slot] = position.y;
+    velX[slot] = velocity.x;
+    velY[slot] = velocity.y;
+    radius[slot] = collisionRadius;
+    // só quem tem tempo de vida ocupa a roda de timers; o tiro some quando ele vence
+    expiry[slot] = TimerHandle();
+    if (steps > 0) {
+        expiry[slot] = SimulationTimers().Schedule(steps, &ProjectileSystem::OnLifetimeEnd, this, slot);
+    }
+    team[slot] = projectileTeam;
+    owner[slot] = projectileOwner;
+    active[slot] = true;
+    return slot;
+}
+
+void ProjectileSystem::Remove(int slot) {
+    if (!active[slot]) return;
+    active[slot] = false;
+    SimulationTimers().Cancel(expiry[slot]);
+    // slot livre fica parado no laço de movimento
+    velX[slot] = 0.0f;
+    velY[slot] = 0.0f;
+    freeSlots[freeCount++] = slot;
+}
+
+void ProjectileSystem::OnLifetimeEnd(void* system, int slot) {
+    static_cast<ProjectileSystem*>(system)->Remove(slot);
+}
+
+void ProjectileSystem::Clear(ProjectileTeam projectileTeam) {
+    for (int i = 0; i < usedSlots; i++) {
+        if (active[i] && team[i] == projectileTeam) Remove(i);
+    }
+}
+
+void ProjectileSystem::Clear() {
+    for (int i = 0; i < usedSlots; i++) {
+        if (active[i]) SimulationTimers().Cancel(expiry[i]);
+        active[i] = false;
+        velX[i] = velY[i] = 0.0f;
+    }
+    freeCount = 0;
+    usedSlots = 0;
+}
+
+void ProjectileSystem::TrimUsedSlots() {
+    int used = usedSlots;
+    while (used > 0 && !active[used - 1]) used--;
+    if (used == usedSlots) return;
+    usedSlots = used;
+
+    // os slots acima do novo fim voltam a ser entregues em ordem, fora da lista livre
+    int kept = 0;
+    for (int i = 0; i < freeCount; i++) {
+        if (freeSlots[i] < usedSlots) freeSlots[kept++] = freeSlots[i];
+    }
+    freeCount = kept;
+}
+
+void ProjectileSystem::Update(BSplineTrack* track, ExplosionManager* explosions) {
+    // uma vez por passo, e não a cada Remove, para não varrer a lista livre a cada tiro
+    TrimUsedSlots();
+
+    // move todos os slots usados de uma vez; os livres têm velocidade zero e ficam parados
+#ifdef PROJECTILE_USE_SSE
+    for (int i = 0; i < usedSlots; i += 4) {
+        __m128 px = _mm_load_ps(posX + i);
+        __m128 py = _mm_load_ps(posY + i);
+        _mm_store_ps(prevX + i, px);
+        _mm_store_ps(prevY + i, py);
+        _mm_store_ps(posX + i, _mm_add_ps(px, _mm_load_ps(velX + i)));
+        _mm_store_ps(posY + i, _mm_add_ps(py, _mm_load_ps(velY + i)));
+    }
+#else
+    for (int i = 0; i < usedSlots; i++) {
+        prevX[i] = posX[i];
+        prevY[i] = posY[i];
+        posX[i] += velX[i];
+        posY[i] += velY[i];
+    }
+#endif
+
+    for (int i = 0; i < usedSlots; i++) {
+        if (!active[i] || !track) continue;
+
+        // longe das bordas o tiro não alcança parede neste passo e dispensa o teste exato
+        float margin = track->wallClearance(Vector2(prevX[i], prevY[i])) - radius[i];
+        if (margin > 0.0f && margin * margin > velX[i] * velX[i] + velY[i] * velY[i]) continue;
+
+        // círculo varrido do passo inteiro: tiros rápidos não atravessam a borda
+        SweepHit hit;
+        if (track->sweepCircle(Vector2(prevX[i], prevY[i]), GetPosition(i), radius[i], hit)) {
+            // o tiro para no ponto do contato
+            posX[i] = prevX[i] + velX[i] * hit.time;
+            posY[i] = prevY[i] + velY[i] * hit.time;
+
+            // só os tiros dos jogadores explodem na parede
+            if (team[i] == ProjectileTeam::Player) {
+                Explode(i, explosions);
+            }
+            Remove(i);
+        }
+    }
+}
+
+void ProjectileSystem::Explode(int slot, ExplosionManager* explosions) const {
+    if (!explosions) return;
+
+    // cria explosão na posição atual usando velocidade como direção
+    Vector2 position = GetPosition(slot);
+    explosions->CreateExplosion(position, GetVelocity(slot), 30); // 30 partículas para efeito rico
+
+    // deixa uma queimadura permanente no chão
+    DecalLayer::Stamp(DecalKind::Scorch, position, std::atan2(velY[slot], velX[slot]), radius[slot]);
+}
+
+void ProjectileSystem::Render(float alpha, const Camera* view) const {
+    for (int i = 0; i < usedSlots; i++) {
+        if (!active[i]) continue;
+
+        Vector2 drawPos(prevX[i] + (posX[i] - prevX[i]) * alpha, prevY[i] + (posY[i] - prevY[i]) * alpha);
+        if (team[i] == ProjectileTeam::Player) {
+            if (view && !view->IsCircleVisible(drawPos, PLAYER_DRAW_RADIUS)) continue;
+            CV::color(1.0f, 0.7f, 0.0f); // laranja-amarelo para projéteis
+            CV::circleFill(drawPos.x, drawPos.y, PLAYER_DRAW_RADIUS, 10);
+        } else {
+            if (view && !view->IsCircleVisible(drawPos, radius[i])) continue;
+            CV::color(1.0f, 0.5f, 0.0f); // laranja brilhante para melhor visibilidade
+            CV::circleFill(drawPos.x, drawPos.y, radius[i], 8);
+            CV::color(1.0f, 0.2f, 0.0f); // contorno vermelho
+            CV::circle(drawPos.x, drawPos.y, radius[i], 8);
+        }
+    }
+}
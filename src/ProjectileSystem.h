@@ -0,0 +1,129 @@
+/**
+ * ProjectileSystem.h
+ * Todos os projéteis do jogo (tiros dos tanques e dos atiradores) num único lugar.
+ * Os dados ficam em vetores de tamanho fixo, um por campo (estrutura de arrays),
+ * e os espaços livres são reaproveitados por uma lista livre: durante o jogo
+ * nada é alocado, e os laços de atualização percorrem memória contígua.
+ * Cada projétil guarda seu time e o índice do dono (jogador ou alvo).
+ * O movimento usa SSE quando disponível e a grade de distâncias da pista
+ * descarta de uma vez os tiros longe das bordas, para aguentar milhares
+ * de tiros inimigos ao mesmo tempo.
+ */
+
+#ifndef __PROJECTILE_SYSTEM_H__
+#define __PROJECTILE_SYSTEM_H__
+
+#include "Vector2.h"
+#include "TimerWheel.h"
+#include <algorithm>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define PROJECTILE_USE_SSE 1
+#endif
+
+class BSplineTrack;
+class Camera;
+class ExplosionManager;
+
+enum class ProjectileTeam : unsigned char {
+    Player,  // dono = índice do jogador
+    Enemy    // dono = índice do alvo em g_targets
+};
+
+class ProjectileSystem {
+public:
+    static const int CAPACITY = 16384;   // múltiplo de 4 para o laço com SSE
+
+    static constexpr float PLAYER_RADIUS = 4.0f;       // raio de colisão dos tiros do tanque
+    static constexpr float PLAYER_DRAW_RADIUS = 8.0f;
+    static const int PLAYER_LIFETIME = 300;            // passos até o tiro do tanque sumir
+    static constexpr float ENEMY_RADIUS = 5.0f;
+    static const int NO_LIFETIME = -1;                 // tiros inimigos só somem ao bater na pista
+
+    // campos de cada projétil, indexados pelo slot
+    alignas(16) float posX[CAPACITY];
+    alignas(16) float posY[CAPACITY];
+    alignas(16) float prevX[CAPACITY];   // posição do passo anterior para interpolação
+    alignas(16) float prevY[CAPACITY];
+    alignas(16) float velX[CAPACITY];
+    alignas(16) float velY[CAPACITY];
+    float radius[CAPACITY];
+    TimerHandle expiry[CAPACITY];             // fim do tempo de vida na roda de timers (se tiver)
+    ProjectileTeam team[CAPACITY];
+    int owner[CAPACITY];
+    bool active[CAPACITY];
+
+    ProjectileSystem();
+
+    // a cópia (usada no snapshot) só leva os slots já usados
+    ProjectileSystem(const ProjectileSystem& other) : freeCount(0), usedSlots(0) {
+        *this = other;
+    }
+
+    ProjectileSystem& operator=(const ProjectileSystem& other) {
+        if (this == &other) return *this;
+        usedSlots = other.usedSlots;
+        freeCount = other.freeCount;
+        Copy(posX, other.posX); Copy(posY, other.posY);
+        Copy(prevX, other.prevX); Copy(prevY, other.prevY);
+        Copy(velX, other.velX); Copy(velY, other.velY);
+        Copy(radius, other.radius); Copy(expiry, other.expiry);
+        Copy(team, other.team); Copy(owner, other.owner); Copy(active, other.active);
+        std::copy(other.freeSlots, other.freeSlots + freeCount, freeSlots);
+        return *this;
+    }
+
+    // retorna o slot usado, ou -1 se não houver espaço
+    int Spawn(ProjectileTeam projectileTeam, int projectileOwner, const Vector2& position,
+              const Vector2& velocity, float collisionRadius, int steps);
+    void Remove(int slot);
+    void Clear(ProjectileTeam projectileTeam);
+    void Clear();
+
+    // um além do último slot ocupado (no início do passo); os laços vão de 0 até aqui
+    int GetUsedSlots() const { return usedSlots; }
+
+    Vector2 GetPosition(int slot) const { return Vector2(posX[slot], posY[slot]); }
+    Vector2 GetVelocity(int slot) const { return Vector2(velX[slot], velY[slot]); }
+
+    // move tudo um passo e remove o que bateu na pista (teste contínuo, sem limite de velocidade).
+    // só os tiros perto de uma borda fazem o teste exato. tiros dos jogadores explodem na parede
+    void Update(BSplineTrack* track, ExplosionManager* explosions);
+
+    // explosão e marca no chão no ponto onde o tiro parou
+    void Explode(int slot, ExplosionManager* explosions) const;
+
+    // troca o dono dos tiros de um time por remap(dono); se o novo dono for -1 o tiro é removido
+    template <typename Remap>
+    void RemapOwners(ProjectileTeam projectileTeam, Remap remap) {
+        for (int i = 0; i < usedSlots; i++) {
+            if (!active[i] || team[i] != projectileTeam) continue;
+            int newOwner = remap(owner[i]);
+            if (newOwner < 0) {
+                Remove(i);
+            } else {
+                owner[i] = newOwner;
+            }
+        }
+    }
+
+    void Render(float alpha = 1.0f, const Camera* view = nullptr) const;
+
+private:
+    int freeSlots[CAPACITY];  // pilha de slots livres abaixo de usedSlots
+    int freeCount;
+    int usedSlots;
+
+    static void OnLifetimeEnd(void* system, int slot);
+
+    // descarta os slots livres do fim, para os laços não continuarem no tamanho da maior rajada
+    void TrimUsedSlots();
+
+    template <typename T>
+    void Copy(T* field, const T* source) {
+        std::copy(source, source + usedSlots, field);
+    }
+};
+
+#endif
@@ -0,0 +1,94 @@
+/**
+ * QualityGovernor.cpp
+ * Implementa a escolha do nível de qualidade a partir dos tempos de quadro.
+ * Desce de nível rápido quando o orçamento é estourado e sobe devagar,
+ * com espera crescente para não ficar oscilando entre dois níveis.
+ */
+
+#include "QualityGovernor.h"
+#include <cstdio>
+
+// do nível mais bonito (0) para o mais leve
+static const QualityLevel LEVELS[QualityGovernor::NUM_LEVELS] = {
+    // partículas, círculos, pista, MSAA, escala
+    { 1.00f, 1.00f, 1.00f, true,  1.00f },
+    { 0.75f, 1.00f, 0.75f, true,  1.00f },
+    { 0.50f, 0.75f, 0.50f, false, 1.00f },
+    { 0.35f, 0.60f, 0.40f, false, 0.75f },
+    { 0.20f, 0.50f, 0.30f, false, 0.50f }
+};
+
+// margens em relação ao orçamento
+static const float DOWNGRADE_FACTOR = 1.10f; // média acima disso desce de nível
+static const float UPGRADE_FACTOR = 0.85f;   // média abaixo disso conta como janela boa
+static const int MIN_UPGRADE_DELAY = 3;      // janelas boas para tentar subir
+static const int MAX_UPGRADE_DELAY = 48;
+
+QualityGovernor::QualityGovernor(float budgetMs)
+    : frameBudgetMs(budgetMs), circleDetailUsed(true), level(0), frameCount(0), goodWindows(0),
+      upgradeDelayWindows(MIN_UPGRADE_DELAY), windowsSinceUpgrade(MAX_UPGRADE_DELAY) {
+    for (int i = 0; i < WINDOW_FRAMES; i++) {
+        frameTimes[i] = 0.0f;
+    }
+}
+
+const QualityLevel& QualityGovernor::GetLevel() const {
+    return LEVELS[level];
+}
+
+bool QualityGovernor::AddFrame(float frameMs) {
+    frameTimes[frameCount % WINDOW_FRAMES] = frameMs;
+    frameCount++;
+
+    // só avalia quando uma janela inteira foi coletada
+    if (frameCount < WINDOW_FRAMES) return false;
+    frameCount = 0;
+
+    float sum = 0.0f;
+    for (int i = 0; i < WINDOW_FRAMES; i++) {
+        sum += frameTimes[i];
+    }
+    float averageMs = sum / WINDOW_FRAMES;
+    windowsSinceUpgrade++;
+
+    if (averageMs > frameBudgetMs * DOWNGRADE_FACTOR) {
+        goodWindows = 0;
+        if (level < NUM_LEVELS - 1) {
+            // se acabou de subir e já estourou, espera o dobro antes de tentar de novo
+            if (windowsSinceUpgrade <= 2 && upgradeDelayWindows < MAX_UPGRADE_DELAY) {
+                upgradeDelayWindows *= 2;
+            }
+            SetLevel(level + 1, averageMs);
+            return true;
+        }
+        return false;
+    }
+
+    if (averageMs < frameBudgetMs * UPGRADE_FACTOR) {
+        goodWindows++;
+        if (level > 0 && goodWindows >= upgradeDelayWindows) {
+            goodWindows = 0;
+            windowsSinceUpgrade = 0;
+            SetLevel(level - 1, averageMs);
+            return true;
+        }
+    } else {
+        goodWindows = 0;
+    }
+    return false;
+}
+
+void QualityGovernor::SetLevel(int newLevel, float averageMs) {
+    const QualityLevel& q = LEVELS[newLevel];
+    char circles[16];
+    if (circleDetailUsed) {
+        snprintf(circles, sizeof(circles), "%.0f%%", q.circleDetail * 100.0f);
+    } else {
+        snprintf(circles, sizeof(circles), "sdf");
+    }
+    printf("[qualidade] nivel %d -> %d (media %.2f ms, orcamento %.2f ms): particulas %.0f%%, circulos %s, pista %.0f%%, MSAA %s, escala %.0f%%\n",
+           level, newLevel, averageMs, frameBudgetMs,
+           q.particleScale * 100.0f, circles, q.trackDetail * 100.0f,
+           q.multisample ? "ligado" : "desligado", q.renderScale * 100.0f);
+    level = newLevel;
+}
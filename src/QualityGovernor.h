@@ -0,0 +1,47 @@
+/**
+ * QualityGovernor.h
+ * Controle adaptativo de qualidade gráfica.
+ * Observa o tempo dos quadros recentes e sobe ou desce um nível de
+ * qualidade para manter o jogo dentro de um orçamento de tempo por quadro.
+ */
+
+#ifndef __QUALITY_GOVERNOR_H__
+#define __QUALITY_GOVERNOR_H__
+
+// valores de cada nível de qualidade
+struct QualityLevel {
+    float particleScale;   // fração das partículas emitidas por explosão
+    float circleDetail;    // fração dos lados usados para desenhar círculos
+    float trackDetail;     // fração da densidade de tesselação da pista
+    bool multisample;      // MSAA ligado/desligado
+    float renderScale;     // escala da resolução interna do mundo
+};
+
+class QualityGovernor {
+public:
+    static const int NUM_LEVELS = 5;
+    static const int WINDOW_FRAMES = 60; // quadros avaliados por vez
+
+    float frameBudgetMs; // orçamento de tempo por quadro
+    bool circleDetailUsed; // false quando os círculos não têm lados (shader SDF): o detalhe é ignorado
+
+    QualityGovernor(float budgetMs = 1000.0f / 60.0f);
+
+    // registra o tempo do último quadro; retorna true se o nível mudou
+    bool AddFrame(float frameMs);
+
+    int GetLevelIndex() const { return level; }
+    const QualityLevel& GetLevel() const;
+
+private:
+    int level;                        // 0 = qualidade máxima
+    float frameTimes[WINDOW_FRAMES];  // janela circular dos últimos quadros
+    int frameCount;
+    int goodWindows;                  // janelas seguidas abaixo do orçamento
+    int upgradeDelayWindows;          // janelas boas necessárias para subir de nível
+    int windowsSinceUpgrade;
+
+    void SetLevel(int newLevel, float averageMs);
+};
+
+#endif
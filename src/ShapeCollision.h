@@ -0,0 +1,325 @@
+/**
+ * ShapeCollision.h
+ * Testes exatos de sobreposição entre formas 2D: círculo, caixa orientada,
+ * polígono convexo e estrela (união do pentágono do meio com um triângulo por ponta).
+ * O teste de cada par de formas é escolhido em tempo de compilação por ShapeTest<A, B>.
+ * Os testes em lote (uma forma contra vários círculos) usam SSE quando disponível.
+ * SweepCircles é o teste contínuo entre dois círculos em movimento.
+ */
+
+#ifndef __SHAPE_COLLISION_H__
+#define __SHAPE_COLLISION_H__
+
+#include "Vector2.h"
+#include <cmath>
+#include <algorithm>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define SHAPES_USE_SSE 1
+#endif
+
+struct CircleShape {
+    Vector2 center;
+    float radius;
+
+    CircleShape(const Vector2& c, float r) : center(c), radius(r) {}
+};
+
+// caixa orientada: axisX/axisY é a direção do lado de meia medida halfW
+struct BoxShape {
+    Vector2 center;
+    float axisX, axisY;
+    float halfW, halfH;
+
+    BoxShape(const Vector2& c, float hw, float hh, float angle)
+        : center(c), axisX(std::cos(angle)), axisY(std::sin(angle)), halfW(hw), halfH(hh) {}
+};
+
+// polígono convexo, em qualquer sentido de giro
+struct PolygonShape {
+    static const int MAX_POINTS = 8;
+    Vector2 points[MAX_POINTS];
+    int count;
+
+    PolygonShape() : count(0) {}
+
+    void Add(float x, float y) {
+        if (count < MAX_POINTS) points[count++].set(x, y);
+    }
+
+    static PolygonShape FromBox(const BoxShape& box) {
+        PolygonShape poly;
+        float wx = box.axisX * box.halfW, wy = box.axisY * box.halfW;
+        float hx = -box.axisY * box.halfH, hy = box.axisX * box.halfH;
+        poly.Add(box.center.x - wx - hx, box.center.y - wy - hy);
+        poly.Add(box.center.x + wx - hx, box.center.y + wy - hy);
+        poly.Add(box.center.x + wx + hx, box.center.y + wy + hy);
+        poly.Add(box.center.x - wx + hx, box.center.y - wy + hy);
+        return poly;
+    }
+};
+
+// estrela de NUM_POINTS pontas com os mesmos vértices do desenho:
+// começa numa ponta externa em rotation - 90° e alterna externo/interno
+struct StarShape {
+    static const int NUM_POINTS = 5;
+    PolygonShape core;               // pentágono dos vértices internos
+    PolygonShape tips[NUM_POINTS];   // ponta externa com os dois internos vizinhos
+    CircleShape bounds;              // círculo envolvente para descartar rápido
+
+    StarShape(const Vector2& c, float outerRadius, float innerRadius, float rotation)
+        : bounds(c, outerRadius) {
+        Vector2 ring[NUM_POINTS * 2];
+        float angle = rotation - static_cast<float>(M_PI) / 2.0f;
+        for (int i = 0; i < NUM_POINTS * 2; i++) {
+            float r = (i % 2 == 0) ? outerRadius : innerRadius;
+            ring[i].set(c.x + r * std::cos(angle), c.y + r * std::sin(angle));
+            angle += static_cast<float>(M_PI) / NUM_POINTS;
+        }
+        for (int i = 0; i < NUM_POINTS; i++) {
+            const Vector2& before = ring[(2 * i + NUM_POINTS * 2 - 1) % (NUM_POINTS * 2)];
+            const Vector2& tip = ring[2 * i];
+            const Vector2& after = ring[2 * i + 1];
+            tips[i].Add(before.x, before.y);
+            tips[i].Add(tip.x, tip.y);
+            tips[i].Add(after.x, after.y);
+            core.Add(after.x, after.y);
+        }
+    }
+};
+
+// funções auxiliares dos testes
+namespace ShapeDetail {
+
+inline void Project(const PolygonShape& poly, float ax, float ay, float& lo, float& hi) {
+    lo = hi = poly.points[0].x * ax + poly.points[0].y * ay;
+    for (int i = 1; i < poly.count; i++) {
+        float p = poly.points[i].x * ax + poly.points[i].y * ay;
+        lo = std::min(lo, p);
+        hi = std::max(hi, p);
+    }
+}
+
+// procura um eixo separador entre as normais das arestas de a
+inline bool HasSeparatingAxis(const PolygonShape& a, const PolygonShape& b) {
+    for (int i = 0; i < a.count; i++) {
+        const Vector2& p = a.points[i];
+        const Vector2& q = a.points[(i + 1) % a.count];
+        float ax = q.y - p.y, ay = p.x - q.x;
+        float aLo, aHi, bLo, bHi;
+        Project(a, ax, ay, aLo, aHi);
+        Project(b, ax, ay, bLo, bHi);
+        if (aHi < bLo || bHi < aLo) return true;
+    }
+    return false;
+}
+
+inline bool PointInPolygon(const PolygonShape& poly, const Vector2& point) {
+    bool hasPositive = false, hasNegative = false;
+    for (int i = 0; i < poly.count; i++) {
+        const Vector2& p = poly.points[i];
+        const Vector2& q = poly.points[(i + 1) % poly.count];
+        float cross = (q.x - p.x) * (point.y - p.y) - (q.y - p.y) * (point.x - p.x);
+        if (cross > 0.0f) hasPositive = true;
+        if (cross < 0.0f) hasNegative = true;
+        if (hasPositive && hasNegative) return false;
+    }
+    return true;
+}
+
+inline float SegmentDistSq(const Vector2& point, const Vector2& a, const Vector2& b) {
+    float ex = b.x - a.x, ey = b.y - a.y;
+    float lenSq = ex * ex + ey * ey;
+    float s = lenSq > 1e-12f ? ((point.x - a.x) * ex + (point.y - a.y) * ey) / lenSq : 0.0f;
+    s = std::max(0.0f, std::min(1.0f, s));
+    float dx = point.x - (a.x + ex * s), dy = point.y - (a.y + ey * s);
+    return dx * dx + dy * dy;
+}
+
+} // namespace ShapeDetail
+
+// par sem especialização: tenta o par invertido
+template <typename A, typename B>
+struct ShapeTest {
+    static bool Overlap(const A& a, const B& b) { return ShapeTest<B, A>::Overlap(b, a); }
+};
+
+template <>
+struct ShapeTest<CircleShape, CircleShape> {
+    static bool Overlap(const CircleShape& a, const CircleShape& b) {
+        float dx = b.center.x - a.center.x, dy = b.center.y - a.center.y;
+        float r = a.radius + b.radius;
+        return dx * dx + dy * dy <= r * r;
+    }
+};
+
+template <>
+struct ShapeTest<CircleShape, BoxShape> {
+    static bool Overlap(const CircleShape& c, const BoxShape& box) {
+        // centro do círculo no espaço da caixa, preso aos limites dela
+        float dx = c.center.x - box.center.x, dy = c.center.y - box.center.y;
+        float lx = dx * box.axisX + dy * box.axisY;
+        float ly = dy * box.axisX - dx * box.axisY;
+        float ex = lx - std::max(-box.halfW, std::min(box.halfW, lx));
+        float ey = ly - std::max(-box.halfH, std::min(box.halfH, ly));
+        return ex * ex + ey * ey <= c.radius * c.radius;
+    }
+};
+
+template <>
+struct ShapeTest<CircleShape, PolygonShape> {
+    static bool Overlap(const CircleShape& c, const PolygonShape& poly) {
+        if (ShapeDetail::PointInPolygon(poly, c.center)) return true;
+        float rSq = c.radius * c.radius;
+        for (int i = 0; i < poly.count; i++) {
+            if (ShapeDetail::SegmentDistSq(c.center, poly.points[i], poly.points[(i + 1) % poly.count]) <= rSq) return true;
+        }
+        return false;
+    }
+};
+
+template <>
+struct ShapeTest<PolygonShape, PolygonShape> {
+    static bool Overlap(const PolygonShape& a, const PolygonShape& b) {
+        return !ShapeDetail::HasSeparatingAxis(a, b) && !ShapeDetail::HasSeparatingAxis(b, a);
+    }
+};
+
+template <>
+struct ShapeTest<BoxShape, PolygonShape> {
+    static bool Overlap(const BoxShape& box, const PolygonShape& poly) {
+        return ShapeTest<PolygonShape, PolygonShape>::Overlap(PolygonShape::FromBox(box), poly);
+    }
+};
+
+template <>
+struct ShapeTest<BoxShape, BoxShape> {
+    static bool Overlap(const BoxShape& a, const BoxShape& b) {
+        return ShapeTest<PolygonShape, PolygonShape>::Overlap(PolygonShape::FromBox(a), PolygonShape::FromBox(b));
+    }
+};
+
+// qualquer forma contra a estrela: descarta pelo círculo envolvente e testa cada parte
+template <typename A>
+struct ShapeTest<A, StarShape> {
+    static bool Overlap(const A& a, const StarShape& star) {
+        if (!ShapeTest<A, CircleShape>::Overlap(a, star.bounds)) return false;
+        if (ShapeTest<A, PolygonShape>::Overlap(a, star.core)) return true;
+        for (int i = 0; i < StarShape::NUM_POINTS; i++) {
+            if (ShapeTest<A, PolygonShape>::Overlap(a, star.tips[i])) return true;
+        }
+        return false;
+    }
+};
+
+template <typename A, typename B>
+inline bool ShapesOverlap(const A& a, const B& b) {
+    return ShapeTest<A, B>::Overlap(a, b);
+}
+
+// uma forma contra count círculos (x, y, r em arrays paralelos).
+// hits[i] = 1 se o círculo i sobrepõe a forma; retorna quantos sobrepõem
+template <typename S>
+inline int OverlapCircles(const S& shape, const float* x, const float* y, const float* r, int count, unsigned char* hits) {
+    int numHits = 0;
+    for (int i = 0; i < count; i++) {
+        hits[i] = ShapesOverlap(CircleShape(Vector2(x[i], y[i]), r[i]), shape) ? 1 : 0;
+        numHits += hits[i];
+    }
+    return numHits;
+}
+
+inline int OverlapCircles(const CircleShape& shape, const float* x, const float* y, const float* r, int count, unsigned char* hits) {
+    int numHits = 0;
+    int i = 0;
+#ifdef SHAPES_USE_SSE
+    const __m128 cx = _mm_set1_ps(shape.center.x);
+    const __m128 cy = _mm_set1_ps(shape.center.y);
+    const __m128 cr = _mm_set1_ps(shape.radius);
+    for (; i + 4 <= count; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), cx);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), cy);
+        __m128 sum = _mm_add_ps(_mm_loadu_ps(r + i), cr);
+        __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        int mask = _mm_movemask_ps(_mm_cmple_ps(distSq, _mm_mul_ps(sum, sum)));
+        for (int k = 0; k < 4; k++) {
+            hits[i + k] = (mask >> k) & 1;
+            numHits += hits[i + k];
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        hits[i] = ShapesOverlap(CircleShape(Vector2(x[i], y[i]), r[i]), shape) ? 1 : 0;
+        numHits += hits[i];
+    }
+    return numHits;
+}
+
+inline int OverlapCircles(const BoxShape& shape, const float* x, const float* y, const float* r, int count, unsigned char* hits) {
+    int numHits = 0;
+    int i = 0;
+#ifdef SHAPES_USE_SSE
+    const __m128 bx = _mm_set1_ps(shape.center.x);
+    const __m128 by = _mm_set1_ps(shape.center.y);
+    const __m128 ax = _mm_set1_ps(shape.axisX);
+    const __m128 ay = _mm_set1_ps(shape.axisY);
+    const __m128 hw = _mm_set1_ps(shape.halfW);
+    const __m128 hh = _mm_set1_ps(shape.halfH);
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), bx);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), by);
+        __m128 lx = _mm_add_ps(_mm_mul_ps(dx, ax), _mm_mul_ps(dy, ay));
+        __m128 ly = _mm_sub_ps(_mm_mul_ps(dy, ax), _mm_mul_ps(dx, ay));
+        __m128 ex = _mm_sub_ps(lx, _mm_max_ps(_mm_sub_ps(zero, hw), _mm_min_ps(hw, lx)));
+        __m128 ey = _mm_sub_ps(ly, _mm_max_ps(_mm_sub_ps(zero, hh), _mm_min_ps(hh, ly)));
+        __m128 cr = _mm_loadu_ps(r + i);
+        __m128 distSq = _mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey));
+        int mask = _mm_movemask_ps(_mm_cmple_ps(distSq, _mm_mul_ps(cr, cr)));
+        for (int k = 0; k < 4; k++) {
+            hits[i + k] = (mask >> k) & 1;
+            numHits += hits[i + k];
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        hits[i] = ShapesOverlap(CircleShape(Vector2(x[i], y[i]), r[i]), shape) ? 1 : 0;
+        numHits += hits[i];
+    }
+    return numHits;
+}
+
+// dois círculos que andam em linha reta durante o passo (from + delta * t, t de 0 a 1).
+// retorna o primeiro instante em que se tocam; se já começam sobrepostos, time = 0
+inline bool SweepCircles(const Vector2& fromA, const Vector2& deltaA, float radiusA,
+                         const Vector2& fromB, const Vector2& deltaB, float radiusB, float& time) {
+    // movimento relativo: B parado e A andando deltaA - deltaB
+    float dx = fromA.x - fromB.x, dy = fromA.y - fromB.y;
+    float vx = deltaA.x - deltaB.x, vy = deltaA.y - deltaB.y;
+    float r = radiusA + radiusB;
+
+    float c = dx * dx + dy * dy - r * r;
+    if (c <= 0.0f) {
+        time = 0.0f;
+        return true;
+    }
+
+    // |d + v t|^2 = r^2 -> a t^2 + 2 b t + c = 0
+    float a = vx * vx + vy * vy;
+    float b = dx * vx + dy * vy;
+    if (b >= 0.0f || a <= 1e-12f) return false;  // se afastando ou parados
+    float disc = b * b - a * c;
+    if (disc < 0.0f) return false;
+
+    float t = (-b - std::sqrt(disc)) / a;
+    if (t > 1.0f) return false;
+    time = t;
+    return true;
+}
+
+#endif
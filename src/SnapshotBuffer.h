@@ -0,0 +1,56 @@
+/**
+ * SnapshotBuffer.h
+ * Buffer de snapshots entre a thread de simulação e a de renderização.
+ * A simulação escreve sempre num buffer de trás e publica com uma troca
+ * atômica; a renderização lê o snapshot mais recente sem travas.
+ */
+
+#ifndef __SNAPSHOT_BUFFER_H__
+#define __SNAPSHOT_BUFFER_H__
+
+#include <atomic>
+
+// buffer duplo (um para escrita, um para leitura) com um terceiro slot de troca,
+// assim nenhuma das threads espera a outra e o leitor nunca vê um snapshot pela metade
+template <typename T>
+class SnapshotBuffer {
+public:
+    SnapshotBuffer() : writeIndex(0), readIndex(2), middle(1) {}
+
+    // buffer onde a simulação monta o próximo snapshot (somente thread de simulação)
+    T& BeginWrite() {
+        return buffers[writeIndex];
+    }
+
+    // torna o snapshot montado visível para o leitor (somente thread de simulação)
+    void Publish() {
+        int previous = middle.exchange(writeIndex | NEW_DATA_BIT, std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    // snapshot mais recente publicado (somente thread de renderização).
+    // o leitor é dono do buffer retornado até a próxima chamada
+    T& Read() {
+        if (middle.load(std::memory_order_relaxed) & NEW_DATA_BIT) {
+            int previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+            readIndex = previous & INDEX_MASK;
+        }
+        return buffers[readIndex];
+    }
+
+    // indica se existe um snapshot novo ainda não lido
+    bool HasNewData() const {
+        return (middle.load(std::memory_order_relaxed) & NEW_DATA_BIT) != 0;
+    }
+
+private:
+    static const int INDEX_MASK = 3;
+    static const int NEW_DATA_BIT = 4;
+
+    T buffers[3];
+    int writeIndex;          // usado só pela simulação
+    int readIndex;           // usado só pela renderização
+    std::atomic<int> middle; // slot de troca + flag de dado novo
+};
+
+#endif
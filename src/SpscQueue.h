@@ -0,0 +1,52 @@
+/**
+ * SpscQueue.h
+ * Fila circular sem travas para um produtor e um consumidor.
+ * Usada para levar eventos de uma thread a outra (ex: entrada da GLUT
+ * para a thread de simulação) sem mutex e sem alocação.
+ */
+
+#ifndef __SPSC_QUEUE_H__
+#define __SPSC_QUEUE_H__
+
+#include <atomic>
+#include <cstddef>
+
+// capacidade deve ser potência de 2; um slot fica sempre vazio para distinguir cheia de vazia
+template <typename T, size_t Capacity>
+class SpscQueue {
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    // chamado apenas pela thread produtora. Retorna false se a fila estiver cheia
+    bool Push(const T& item) {
+        size_t currentTail = tail.load(std::memory_order_relaxed);
+        size_t nextTail = (currentTail + 1) & MASK;
+        if (nextTail == head.load(std::memory_order_acquire)) {
+            return false; // cheia, o evento é descartado
+        }
+        items[currentTail] = item;
+        tail.store(nextTail, std::memory_order_release);
+        return true;
+    }
+
+    // chamado apenas pela thread consumidora. Retorna false se a fila estiver vazia
+    bool Pop(T& item) {
+        size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = items[currentHead];
+        head.store((currentHead + 1) & MASK, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static_assert((Capacity & (Capacity - 1)) == 0, "capacidade da SpscQueue deve ser potencia de 2");
+    static const size_t MASK = Capacity - 1;
+
+    T items[Capacity];
+    std::atomic<size_t> head; // próximo item a ser lido
+    std::atomic<size_t> tail; // próximo slot livre para escrita
+};
+
+#endif
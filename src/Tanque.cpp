@@ -10,6 +10,7 @@
 #include <cmath> 
 #include <algorithm> 
 #include "BSplineTrack.h" 
+#include "GameClock.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -27,13 +28,14 @@ Tanque::Tanque(float x, float y, float initialSpeed, float initialRotationRate)
     turretRadius = 15.0f;
     cannonLength = 40.0f;
     cannonWidth = 6.0f;
+    bodyColorR = 0.2f;
+    bodyColorG = 0.5f;
+    bodyColorB = 0.2f;
 
     forwardVector.set(cos(baseAngle), sin(baseAngle));
 
     // inicializa membros de colisão
-    lastSafePosition = position;
-    isColliding = false;
-    collisionTimer = 0;
+    isTouchingWall = false;
 
     // inicializa membros relacionados a projéteis
     firingCooldown = 0;
@@ -49,54 +51,27 @@ Tanque::Tanque(float x, float y, float initialSpeed, float initialRotationRate)
 
     // inicializa escudo
     hasShield = false;
-}
-
-void Tanque::Update(float mouseX, float mouseY, bool rotateLeft, bool rotateRight, BSplineTrack* track) {
-    // diminui o tempo de recarga de tiro se ativo
-    if (firingCooldown > 0) {
-        firingCooldown--;
-    }
-
-    // atualiza projéteis
-    UpdateProjectiles(track);
-
-    // atualiza explosões
-    explosions.Update();
-
-    if (isColliding) {
-        // movimento de recuo
-        position.x -= forwardVector.x * speed * REBOUND_SPEED_FACTOR;
-        position.y -= forwardVector.y * speed * REBOUND_SPEED_FACTOR;
-        collisionTimer--;
-        if (collisionTimer <= 0) {
-            isColliding = false;
-        }
 
-        // a torre ainda pode mirar durante o recuo
-        float dx_turret = mouseX - position.x;
-        float dy_turret = mouseY - position.y;
-        float targetAngle_turret = atan2(dy_turret, dx_turret);
-        float currentTopAngle_turret = fmod(topAngle + M_PI, 2 * M_PI) - M_PI;
-        if (currentTopAngle_turret < -M_PI) currentTopAngle_turret += 2 * M_PI;
-        float angleDifference_turret = targetAngle_turret - currentTopAngle_turret;
-        if (angleDifference_turret > M_PI) angleDifference_turret -= 2 * M_PI;
-        else if (angleDifference_turret < -M_PI) angleDifference_turret += 2 * M_PI;
-
-        float maxRotationThisFrame_turret = turretRotationSpeed; // assumindo por quadro
+    ResetInterpolation();
+}
 
-        if (std::abs(angleDifference_turret) <= maxRotationThisFrame_turret) {
-            topAngle = targetAngle_turret;
-        } else {
-            topAngle += (angleDifference_turret > 0 ? maxRotationThisFrame_turret : -maxRotationThisFrame_turret);
-        }
-        topAngle = fmod(topAngle, 2 * M_PI);
-        if (topAngle < 0) topAngle += 2 * M_PI;
+// posição interpolada entre o passo anterior e o atual
+Vector2 Tanque::GetRenderPosition(float alpha) const {
+    return previousPosition.lerp(position, alpha);
+}
 
-        return; // pula movimento normal e novas verificações de colisão
-    }
+// descarta o estado anterior (usado quando o tanque é teletransportado)
+void Tanque::ResetInterpolation() {
+    previousPosition = position;
+    previousBaseAngle = baseAngle;
+    previousTopAngle = topAngle;
+}
 
-    // não está colidindo e recuando: lógica de atualização normal
-    lastSafePosition = position;
+void Tanque::Update(float mouseX, float mouseY, bool rotateLeft, bool rotateRight, BSplineTrack* track) {
+    // guarda o estado do passo anterior para a interpolação da renderização
+    previousPosition = position;
+    previousBaseAngle = baseAngle;
+    previousTopAngle = topAngle;
 
     // atualiza rotação da base
     if (rotateLeft) {
@@ -118,15 +93,13 @@ void Tanque::Update(float mouseX, float mouseY, bool rotateLeft, bool rotateRigh
     tentativePosition.x += forwardVector.x * speed;
     tentativePosition.y += forwardVector.y * speed;
 
-    // armazena posição atual, ajusta para tentativa para verificação de colisão
-    Vector2 currentActualPosition = position;
+    // move para a posição tentativa e deixa a colisão corrigir o que entrou na parede
     position = tentativePosition;
 
-    CheckCollisionAndRespond(track); 
-
+    CheckCollisionAndRespond(track);
 
     // atualiza o ângulo superior (torre) para apontar para o mouse
-    float dx = mouseX - position.x; // usa a posição (potencialmente revertida)
+    float dx = mouseX - position.x; // usa a posição já corrigida pela colisão
     float dy = mouseY - position.y;
     float targetAngle = atan2(dy, dx);
 
@@ -156,30 +129,27 @@ void Tanque::Update(float mouseX, float mouseY, bool rotateLeft, bool rotateRigh
     }
 }
 
-void Tanque::Render() {
-    // renderiza projéteis primeiro (para que o tanque apareça acima deles)
-    for (auto& proj : projectiles) {
-        proj.Render();
-    }
-
-    // renderiza explosões antes do tanque
-    explosions.Render();
+void Tanque::Render(float alpha) {
+    // estado interpolado entre os dois últimos passos da simulação
+    Vector2 drawPos = GetRenderPosition(alpha);
+    float drawBaseAngle = InterpolateAngle(previousBaseAngle, baseAngle, alpha);
+    float drawTopAngle = InterpolateAngle(previousTopAngle, topAngle, alpha);
 
     // desenha barra de vida abaixo do tanque (alterado de acima)
     float healthBarWidth = baseWidth * 1.2f;  // torna-a ligeiramente mais larga que o tanque
     float healthBarHeight = 5.0f;
-    float healthBarY = position.y + baseHeight / 2.0f + 5.0f; // posiciona abaixo do tanque em vez de acima
+    float healthBarY = drawPos.y + baseHeight / 2.0f + 5.0f; // posiciona abaixo do tanque em vez de acima
     float healthPercent = static_cast<float>(health) / maxHealth;
 
     // fundo da barra de vida (vermelho)
     CV::color(1.0f, 0.2f, 0.2f);
-    CV::rectFill(position.x - healthBarWidth / 2.0f, healthBarY,
-                position.x + healthBarWidth / 2.0f, healthBarY + healthBarHeight);
+    CV::rectFill(drawPos.x - healthBarWidth / 2.0f, healthBarY,
+                drawPos.x + healthBarWidth / 2.0f, healthBarY + healthBarHeight);
 
     // preenchimento da barra de vida (verde)
     CV::color(0.2f, 0.8f, 0.2f);
-    CV::rectFill(position.x - healthBarWidth / 2.0f, healthBarY,
-                position.x - healthBarWidth / 2.0f + healthBarWidth * healthPercent, healthBarY + healthBarHeight);
+    CV::rectFill(drawPos.x - healthBarWidth / 2.0f, healthBarY,
+                drawPos.x - healthBarWidth / 2.0f + healthBarWidth * healthPercent, healthBarY + healthBarHeight);
 
     // usa um efeito de flash quando o tanque está invulnerável (atingido)
     if (isInvulnerable) {
@@ -190,10 +160,10 @@ void Tanque::Render() {
                 CV::color(1.0f, 0.2f, 0.2f); // flash vermelho para dano
             }
         } else {
-            CV::color(0.2f, 0.5f, 0.2f); // verde normal
+            CV::color(bodyColorR, bodyColorG, bodyColorB); // cor normal
         }
     } else {
-        CV::color(0.2f, 0.5f, 0.2f); // verde normal
+        CV::color(bodyColorR, bodyColorG, bodyColorB); // cor normal
     }
 
     // renderiza base (retângulo)
@@ -207,13 +177,13 @@ void Tanque::Render() {
     Vector2 p4_local(-halfW,  halfH);
 
     // cantos rotacionados
-    float cosB = cos(baseAngle);
-    float sinB = sin(baseAngle);
+    float cosB = cos(drawBaseAngle);
+    float sinB = sin(drawBaseAngle);
 
-    Vector2 p1_world(p1_local.x * cosB - p1_local.y * sinB + position.x, p1_local.x * sinB + p1_local.y * cosB + position.y);
-    Vector2 p2_world(p2_local.x * cosB - p2_local.y * sinB + position.x, p2_local.x * sinB + p2_local.y * cosB + position.y);
-    Vector2 p3_world(p3_local.x * cosB - p3_local.y * sinB + position.x, p3_local.x * sinB + p3_local.y * cosB + position.y);
-    Vector2 p4_world(p4_local.x * cosB - p4_local.y * sinB + position.x, p4_local.x * sinB + p4_local.y * cosB + position.y);
+    Vector2 p1_world(p1_local.x * cosB - p1_local.y * sinB + drawPos.x, p1_local.x * sinB + p1_local.y * cosB + drawPos.y);
+    Vector2 p2_world(p2_local.x * cosB - p2_local.y * sinB + drawPos.x, p2_local.x * sinB + p2_local.y * cosB + drawPos.y);
+    Vector2 p3_world(p3_local.x * cosB - p3_local.y * sinB + drawPos.x, p3_local.x * sinB + p3_local.y * cosB + drawPos.y);
+    Vector2 p4_world(p4_local.x * cosB - p4_local.y * sinB + drawPos.x, p4_local.x * sinB + p4_local.y * cosB + drawPos.y);
 
     // desenha a base como um polígono preenchido em vez de linhas
     float vx_base[4] = {p1_world.x, p2_world.x, p3_world.x, p4_world.x};
@@ -230,12 +200,12 @@ void Tanque::Render() {
 
     // renderiza topo (torre - círculo e canhão - retângulo)
     CV::color(0.1f, 0.3f, 0.1f); // verde mais escuro para torre
-    CV::circleFill(position.x, position.y, turretRadius, 20); // desenha base da torre
+    CV::circleFill(drawPos.x, drawPos.y, turretRadius, 20); // desenha base da torre
 
     // cálculos do canhão
     float halfCW = cannonWidth / 2.0f;
-    float cosT = cos(topAngle);
-    float sinT = sin(topAngle);
+    float cosT = cos(drawTopAngle);
+    float sinT = sin(drawTopAngle);
 
     // pontos relativos à posição do tanque
     Vector2 c1_local(0, -halfCW);
@@ -244,10 +214,10 @@ void Tanque::Render() {
     Vector2 c4_local(cannonLength,  halfCW);
 
     // rotaciona estes pontos locais pelo topAngle e adiciona à posição do tanque
-    Vector2 c1(position.x + (c1_local.x * cosT - c1_local.y * sinT), position.y + (c1_local.x * sinT + c1_local.y * cosT));
-    Vector2 c2(position.x + (c2_local.x * cosT - c2_local.y * sinT), position.y + (c2_local.x * sinT + c2_local.y * cosT));
-    Vector2 c3(position.x + (c3_local.x * cosT - c3_local.y * sinT), position.y + (c3_local.x * sinT + c3_local.y * cosT));
-    Vector2 c4(position.x + (c4_local.x * cosT - c4_local.y * sinT), position.y + (c4_local.x * sinT + c4_local.y * cosT));
+    Vector2 c1(drawPos.x + (c1_local.x * cosT - c1_local.y * sinT), drawPos.y + (c1_local.x * sinT + c1_local.y * cosT));
+    Vector2 c2(drawPos.x + (c2_local.x * cosT - c2_local.y * sinT), drawPos.y + (c2_local.x * sinT + c2_local.y * cosT));
+    Vector2 c3(drawPos.x + (c3_local.x * cosT - c3_local.y * sinT), drawPos.y + (c3_local.x * sinT + c3_local.y * cosT));
+    Vector2 c4(drawPos.x + (c4_local.x * cosT - c4_local.y * sinT), drawPos.y + (c4_local.x * sinT + c4_local.y * cosT));
 
     // desenha o canhão como um polígono preenchido em vez de linhas
     float vx_cannon[4] = {c1.x, c2.x, c4.x, c3.x}; // a ordem importa para polígonos convexos
@@ -260,13 +230,13 @@ void Tanque::Render() {
         float cooldownFraction = (float)firingCooldown / firingCooldownReset;
         float barLength = 25.0f * cooldownFraction;
         CV::color(1.0f, 0.3f, 0.3f); // barra vermelha de recarga
-        CV::rectFill(position.x - 12.5f, position.y - turretRadius - 10, position.x - 12.5f + barLength, position.y - turretRadius - 5);
+        CV::rectFill(drawPos.x - 12.5f, drawPos.y - turretRadius - 10, drawPos.x - 12.5f + barLength, drawPos.y - turretRadius - 5);
     }
 }
 
 // novo método para disparar projéteis
-bool Tanque::FireProjectile() {
-    if (firingCooldown > 0) {
+bool Tanque::FireProjectile(ProjectileSystem& projectiles, int owner) {
+    if (SimulationTimers().IsPending(reloadTimer)) {
         return false; // ainda não pode disparar
     }
 
@@ -276,11 +246,14 @@ bool Tanque::FireProjectile() {
     // cria vetor de velocidade baseado na direção do canhão
     Vector2 projectileVelocity(cos(topAngle) * projectileSpeed, sin(topAngle) * projectileSpeed);
 
-    // cria e adiciona o projétil
-    Projectile newProjectile(cannonTip, projectileVelocity);
-    projectiles.push_back(newProjectile);
+    // cria o projétil; sem espaço no sistema o tiro não sai
+    if (projectiles.Spawn(ProjectileTeam::Player, owner, cannonTip, projectileVelocity,
+                          ProjectileSystem::PLAYER_RADIUS, ProjectileSystem::PLAYER_LIFETIME) < 0) {
+        return false;
+    }
 
     // reinicia recarga
+    SimulationTimers().Restart(reloadTimer, firingCooldownReset);
     firingCooldown = firingCooldownReset;
 
     return true;
@@ -294,212 +267,85 @@ Vector2 Tanque::GetCannonTipPosition() const {
     );
 }
 
-// novo método para atualizar projéteis
-void Tanque::UpdateProjectiles(BSplineTrack* track) {
-    // atualiza cada projétil e verifica colisões
-    for (auto& proj : projectiles) {
-        if (proj.active) {
-            proj.Update();
-            // passa o gerenciador de explosões para efeitos de colisão
-            if (proj.CheckCollisionWithTrack(track, &explosions)) {
-                // projétil agora está inativo devido à colisão
-            }
-        }
-    }
-
-    // remove projéteis inativos (usando idioma erase-remove)
-    projectiles.erase(
-        std::remove_if(
-            projectiles.begin(),
-            projectiles.end(),
-            [](const Projectile& p) { return !p.active; }
-        ),
-        projectiles.end()
-    );
-}
-
+// tira a caixa do tanque de dentro das bordas empurrando pela normal de penetração.
+// só a componente que entra na parede é removida, então o tanque desliza ao longo dela
 void Tanque::CheckCollisionAndRespond(BSplineTrack* track) {
     if (!track) {
-        this->isColliding = false;
+        isTouchingWall = false;
         return;
     }
 
-    // pula dano de saúde se o tanque já estiver invulnerável
-    bool canTakeDamage = !isInvulnerable;
-
-    Vector2 currentTankPosition = this->position; // posição tentativa atual do centro do tanque
-
-    // calcula os cantos mundiais do tanque baseado em currentTankPosition e baseAngle
-    float halfW = this->baseWidth / 2.0f;
-    float halfH = this->baseHeight / 2.0f;
-    float cosB = cos(this->baseAngle);
-    float sinB = sin(this->baseAngle);
-
-    Vector2 local_corners[4] = {
-        Vector2(-halfW, -halfH), Vector2(halfW, -halfH),
-        Vector2(halfW,  halfH), Vector2(-halfW,  halfH)
-    };
-    Vector2 world_corners[4];
-    for (int i = 0; i < 4; ++i) {
-        world_corners[i].x = local_corners[i].x * cosB - local_corners[i].y * sinB + currentTankPosition.x;
-        world_corners[i].y = local_corners[i].x * sinB + local_corners[i].y * cosB + currentTankPosition.y;
-    }
-
-    ClosestPointInfo cpiLeft = track->findClosestPointOnCurve(currentTankPosition, CurveSide::Left);
-    ClosestPointInfo cpiRight = track->findClosestPointOnCurve(currentTankPosition, CurveSide::Right);
+    float halfW = baseWidth / 2.0f;
+    float halfH = baseHeight / 2.0f;
 
-    bool collisionThisFrame = false;
+    // nas curvas fechadas o tanque pode encostar em mais de um segmento: resolve o mais profundo de cada vez
+    bool touching = false;
+    for (int i = 0; i < MAX_WALL_PUSHES; ++i) {
+        BoxContact contact;
+        if (!track->collideBox(position, halfW, halfH, baseAngle, wallWindow, contact)) break;
 
-    // verifica colisão com curva esquerda
-    if (cpiLeft.isValid) {
-        float max_projection_left = -FLT_MAX;
-        for (int i = 0; i < 4; ++i) {
-            Vector2 vec_corner_to_cl_point = world_corners[i] - cpiLeft.point;
-            float projection = vec_corner_to_cl_point.x * cpiLeft.normal.x + vec_corner_to_cl_point.y * cpiLeft.normal.y;
-            if (projection > max_projection_left) {
-                max_projection_left = projection;
-            }
-        }
-        if (max_projection_left > 0.0f) {
-            collisionThisFrame = true;
-        }
+        position.x += contact.normal.x * (contact.depth + WALL_SKIN);
+        position.y += contact.normal.y * (contact.depth + WALL_SKIN);
+        touching = true;
     }
 
-    // verifica colisão com curva direita
-    if (!collisionThisFrame && cpiRight.isValid) {
-        float min_projection_right = FLT_MAX;
-        for (int i = 0; i < 4; ++i) {
-            Vector2 vec_corner_to_cr_point = world_corners[i] - cpiRight.point;
-            float projection = vec_corner_to_cr_point.x * cpiRight.normal.x + vec_corner_to_cr_point.y * cpiRight.normal.y;
-            if (projection < min_projection_right) {
-                min_projection_right = projection;
-            }
-        }
-        if (min_projection_right < 0.0f) {
-            collisionThisFrame = true;
-        }
-    }
-
-    if (collisionThisFrame) {
-        this->isColliding = true;
-        this->collisionTimer = COLLISION_REBOUND_FRAMES;
-        this->position = this->lastSafePosition; // reverte para última posição segura conhecida
-
-        // apenas aplica dano se o tanque ainda não estiver invulnerável
-        if (canTakeDamage) {
-            // verifica se temos um escudo para bloquear o dano
-            if (hasShield) {
-                hasShield = false; // consome o escudo
-                // ainda faz o tanque temporariamente invulnerável e pisca
-                isInvulnerable = true;
-                isShieldInvulnerable = true; // define flag para invulnerabilidade de escudo
-                invulnerabilityTimer = INVULNERABILITY_FRAMES;
-            } else {
-                // tanque sofre dano - 25% da saúde máxima (igual à colisão com alvo)
-                int damageTaken = maxHealth / 4;  // 25% da saúde máxima
-                health -= damageTaken;
-                if (health < 0) health = 0;
-
-                // torna o tanque temporariamente invulnerável e pisca (igual às colisões com alvo)
-                isInvulnerable = true;
-                isShieldInvulnerable = false; // dano regular
-                invulnerabilityTimer = INVULNERABILITY_FRAMES;
-            }
-        }
+    // a batida só dá dano no primeiro contato, não enquanto o tanque desliza encostado.
+    // (25% da saúde máxima, igual à colisão com alvo; nada se já estiver invulnerável)
+    if (touching && !isTouchingWall && !isInvulnerable) {
+        ApplyHit(maxHealth / 4);
     }
+    isTouchingWall = touching;
 }
 
-// alterado o tipo de retorno de void para int para corresponder à declaração no header
-int Tanque::CheckTargetCollisions(std::vector<Target>& targets) {
-    // pula se o tanque estiver atualmente invulnerável
-    if (isInvulnerable) {
-        invulnerabilityTimer--;
-        if (invulnerabilityTimer <= 0) {
-            isInvulnerable = false;
-            isShieldInvulnerable = false; // também reinicia a flag de invulnerabilidade de escudo
-        }
-        return -1;
-    }
-
-    // verifica cada alvo para colisão com o tanque
-    for (size_t i = 0; i < targets.size(); i++) {
-        // pula alvos do tipo Star já que são tratados separadamente no loop principal de renderização
-        if (targets[i].type == TargetType::Star) {
-            continue;
-        }
-
-        if (targets[i].active && targets[i].CheckCollisionWithTank(position, baseWidth, baseHeight, baseAngle)) {
-            // verifica se temos um escudo para bloquear o dano
-            if (hasShield) {
-                hasShield = false; // consome o escudo
-                // ainda torna o tanque temporariamente invulnerável e pisca
-                isInvulnerable = true;
-                isShieldInvulnerable = true; // define flag para invulnerabilidade de escudo
-                invulnerabilityTimer = INVULNERABILITY_FRAMES;
-
-                // o alvo sofre dano e deve ser destruído ao colidir com um escudo
-                targets[i].TakeDamage(targets[i].health); // mata o alvo aplicando sua saúde total como dano
-
-                // verifica se o alvo foi destruído por esta colisão
-                if (!targets[i].active) {
-                    return i; // retorna o índice do alvo destruído
-                }
-            } else {
-                // aplica dano normal
-                int damageTaken = maxHealth / 4;  // 25% da saúde máxima
-                health -= damageTaken;
-                if (health < 0) health = 0;
-
-                // torna o tanque temporariamente invulnerável para evitar múltiplos golpes rápidos
-                isInvulnerable = true;
-                isShieldInvulnerable = false; // dano regular
-                invulnerabilityTimer = INVULNERABILITY_FRAMES;
-
-                // o alvo também sofre dano
-                targets[i].TakeDamage(1);
-
-                // verifica se o alvo foi destruído por esta colisão
-                if (!targets[i].active) {
-                    return i; // retorna o índice do alvo destruído
-                }
-            }
+// escudo absorve o golpe; sem escudo o tanque perde damage de vida.
+// nos dois casos fica invulnerável e pisca por um tempo
+void Tanque::ApplyHit(int damage) {
+    if (hasShield) {
+        hasShield = false; // consome o escudo
+        isInvulnerable = true;
+        isShieldInvulnerable = true; // define flag para invulnerabilidade de escudo
+    } else {
+        health -= damage;
+        if (health < 0) health = 0;
 
-            // se acertamos algum alvo, podemos quebrar o loop já que agora estamos invulneráveis
-            break;
-        }
+        isInvulnerable = true;
+        isShieldInvulnerable = false; // dano regular
     }
 
-    return -1; // retorna -1 se nenhum alvo foi destruído
+    invulnerabilityTimer = INVULNERABILITY_FRAMES;
+    SimulationTimers().Restart(invulnerabilityEnd, INVULNERABILITY_FRAMES, &Tanque::OnInvulnerabilityEnd, this);
 }
 
-// adiciona as implementações ausentes de Tanque.h
-int Tanque::CheckProjectileTargetCollision(const Projectile& proj, std::vector<Target>& targets) {
-    if (!proj.active) return -1;
-
-    for (size_t i = 0; i < targets.size(); i++) {
-        if (targets[i].active && targets[i].CheckCollision(proj.position)) {
-            return static_cast<int>(i);
-        }
-    }
-
-    return -1;
+// fim da invulnerabilidade, antes da hora (reinício do jogo) ou pelo timer
+void Tanque::ClearInvulnerability() {
+    SimulationTimers().Cancel(invulnerabilityEnd);
+    isInvulnerable = false;
+    isShieldInvulnerable = false; // também reinicia a flag de invulnerabilidade de escudo
+    invulnerabilityTimer = 0;
 }
 
-bool Tanque::CheckAllProjectilesAgainstTargets(std::vector<Target>& targets, int& hitTargetIndex, int& hitProjectileIndex) {
-    for (size_t i = 0; i < projectiles.size(); i++) {
-        int targetIdx = CheckProjectileTargetCollision(projectiles[i], targets);
-        if (targetIdx >= 0) {
-            hitTargetIndex = targetIdx;
-            hitProjectileIndex = static_cast<int>(i);
+void Tanque::OnInvulnerabilityEnd(void* tank, int) {
+    static_cast<Tanque*>(tank)->ClearInvulnerability();
+}
 
-            // cria explosão ao acertar um alvo
-            projectiles[i].CreateExplosionOnCollision(&explosions);
+void Tanque::RefreshCountdowns() {
+    const TimerWheel& timers = SimulationTimers();
+    firingCooldown = timers.Remaining(reloadTimer);
+    invulnerabilityTimer = timers.Remaining(invulnerabilityEnd);
+}
 
-            return true;
-        }
+// batida do tanque num alvo básico ou atirador; retorna se o alvo foi destruído
+bool Tanque::CollideWithTarget(TargetBody& target) {
+    if (hasShield) {
+        // o alvo deve ser destruído ao colidir com um escudo
+        target.TakeDamage(target.health);
+    } else {
+        // o alvo também sofre dano
+        target.TakeDamage(1);
     }
 
-    hitTargetIndex = -1;
-    hitProjectileIndex = -1;
-    return false;
+    // 25% da saúde máxima
+    ApplyHit(maxHealth / 4);
+
+    return !target.active;
 }
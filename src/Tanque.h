@@ -13,9 +13,9 @@
 #include <cmath>
 #include <vector>
 #include "BSplineTrack.h"
-#include "Projectile.h"
+#include "ProjectileSystem.h"
 #include "Target.h"
-#include "ExplosionManager.h" 
+#include "TimerWheel.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -32,6 +32,14 @@ public:
 
     Vector2 forwardVector; // direção para onde a base está apontando
 
+    // estado do passo anterior, usado para interpolar a renderização
+    Vector2 previousPosition;
+    float previousBaseAngle;
+    float previousTopAngle;
+
+    // cor da base (cada jogador tem a sua)
+    float bodyColorR, bodyColorG, bodyColorB;
+
     // dimensões
     float baseWidth;
     float baseHeight;
@@ -39,56 +47,61 @@ public:
     float cannonLength;
     float cannonWidth;
 
-    // membros relacionados à colisão
-    Vector2 lastSafePosition;
-    bool isColliding;
-    int collisionTimer; // contagem regressiva de quadros para recuo
+    // membros relacionados à colisão com as bordas
+    bool isTouchingWall;        // encostado numa borda no fim do último passo
+    SegmentWindow wallWindow;   // segmentos das bordas perto do tanque, reaproveitados entre passos
 
     // constantes de colisão
-    static const int COLLISION_REBOUND_FRAMES = 90; 
-    static constexpr float REBOUND_SPEED_FACTOR = 0.3f; 
+    static const int MAX_WALL_PUSHES = 4;           // correções por passo
+    static constexpr float WALL_SKIN = 0.01f;       // folga para não ficar encostado por arredondamento
 
-    // membros relacionados a projéteis
+    // membros relacionados a projéteis. a recarga é contada pela roda de timers;
+    // firingCooldown só guarda o que falta para o desenho (ver RefreshCountdowns)
+    TimerHandle reloadTimer;
     int firingCooldown;
     int firingCooldownReset;
     float projectileSpeed;
-    std::vector<Projectile> projectiles;
 
     // membros relacionados à saúde
     int health;
     int maxHealth;
     bool isInvulnerable;
-    int invulnerabilityTimer;
+    TimerHandle invulnerabilityEnd;   // ao vencer, isInvulnerable volta a false
+    int invulnerabilityTimer;         // o que falta, para o pisca-pisca do desenho
     static const int INVULNERABILITY_FRAMES = 60; 
     bool isShieldInvulnerable; 
 
     // adiciona propriedade de escudo
     bool hasShield;
 
-    // adiciona gerenciador de explosão
-    ExplosionManager explosions;
-
     Tanque(float x, float y, float initialSpeed = 1.0f, float initialRotationRate = 0.03f);
 
     void Update(float mouseX, float mouseY, bool rotateLeft, bool rotateRight, BSplineTrack* track);
-    void Render();
+    // desenha o tanque na posição interpolada (projéteis e partículas têm seus próprios sistemas)
+    void Render(float alpha = 1.0f);
+
+    // interpolação entre os dois últimos passos da simulação
+    Vector2 GetRenderPosition(float alpha) const;
+    void ResetInterpolation();
     
-    // métodos relacionados a projéteis
-    bool FireProjectile();
+    // métodos relacionados a projéteis (os tiros ficam no sistema de projéteis, marcados com o índice do jogador)
+    bool FireProjectile(ProjectileSystem& projectiles, int owner);
     Vector2 GetCannonTipPosition() const;
-    void UpdateProjectiles(BSplineTrack* track);
 
-    // verifica se um projétil atinge algum alvo e retorna o índice do alvo atingido ou -1
-    int CheckProjectileTargetCollision(const Projectile& proj, std::vector<Target>& targets);
-    
-    // verifica todos os projéteis contra todos os alvos
-    bool CheckAllProjectilesAgainstTargets(std::vector<Target>& targets, int& hitTargetIndex, int& hitProjectileIndex);
+    // caixa orientada da base, usada nos testes de colisão exatos
+    BoxShape GetBodyShape() const { return BoxShape(position, baseWidth / 2.0f, baseHeight / 2.0f, baseAngle); }
+
+    // dano com escudo e invulnerabilidade (usado por todas as colisões do tanque)
+    void ApplyHit(int damage);
+    void ClearInvulnerability();
+    bool CollideWithTarget(TargetBody& target);
 
-    // altera o tipo de retorno de void para int
-    int CheckTargetCollisions(std::vector<Target>& targets);
+    // copia o que falta em cada timer para os contadores lidos pelo desenho
+    void RefreshCountdowns();
 
 private:
     void CheckCollisionAndRespond(BSplineTrack* track);
+    static void OnInvulnerabilityEnd(void* tank, int);
 };
 
 #endif
@@ -1,160 +1,466 @@
 /**
  * Target.cpp
  * Implementa as funcionalidades dos diferentes tipos de alvos.
- * Cada tipo de alvo tem seu próprio comportamento de renderização, 
- * movimento e interação com o jogador.
+ * Cada tipo tem seu próprio laço de atualização e de renderização,
+ * percorrendo só o array daquele tipo.
  */
 
 #include "Target.h"
+#include "ProjectileSystem.h"
 #include "BSplineTrack.h"
+#include "FlowField.h"
+#include "Broadphase.h"
+#include "GameClock.h"
+#include "BulletPattern.h"
 #include <cmath>
 #include <algorithm> 
 
-Target::Target()
-    : active(false), radius(12.0f), health(2), maxHealth(2), type(TargetType::Basic),
-      aimAngle(0.0f), shootingRadius(250.0f), firingCooldown(0), firingCooldownReset(120),
-      detectionRadius(200.0f), moveSpeed(0.8f), isChasing(false), rotationAngle(0.0f), rotationSpeed(0.05f) {}
+// posição do tanque mais próximo de um ponto
+static Vector2 ClosestTankPosition(const Vector2* tankPositions, int numTanks, const Vector2& position) {
+    Vector2 closest = tankPositions[0];
+    float bestDistSq = position.distSq(closest);
+    for (int i = 1; i < numTanks; i++) {
+        float distSq = position.distSq(tankPositions[i]);
+        if (distSq < bestDistSq) {
+            bestDistSq = distSq;
+            closest = tankPositions[i];
+        }
+    }
+    return closest;
+}
 
-Target::Target(const Vector2& pos, TargetType targetType)
-    : position(pos), active(true), radius(12.0f), health(2), maxHealth(2), type(targetType),
-      aimAngle(0.0f), shootingRadius(200.0f), firingCooldown(0), firingCooldownReset(90),
-      detectionRadius(200.0f), moveSpeed(0.8f), isChasing(false), rotationAngle(0.0f), rotationSpeed(0.05f) {}
+bool TargetSet::IsValid(int id) const {
+    int type = id & 3;
+    return id >= 0 && type < NUM_TARGET_TYPES && IdIndex(id) < static_cast<int>(bodies[type].size());
+}
 
-void Target::Update(const Vector2& tankPosition, BSplineTrack* track) {
-    if (!active) return;
-    
-    // atualiza comportamento baseado no tipo de alvo
+int TargetSet::Add(const Vector2& position, TargetType type) {
+    int t = static_cast<int>(type);
+    int index = static_cast<int>(bodies[t].size());
+    bodies[t].push_back(TargetBody(position));
     if (type == TargetType::Shooter) {
-        // calcula ângulo de mira para o tanque
-        float dx = tankPosition.x - position.x;
-        float dy = tankPosition.y - position.y;
-        aimAngle = atan2(dy, dx);
+        shooters.push_back(ShooterState());
+    } else if (type == TargetType::Star) {
+        stars.push_back(StarState());
+    }
+    return MakeId(type, index);
+}
+
+void TargetSet::Clear() {
+    for (int t = 0; t < NUM_TARGET_TYPES; t++) {
+        bodies[t].clear();
+    }
+    shooters.clear();
+    stars.clear();
+}
+
+void TargetSet::RemoveInactive(ProjectileSystem& projectiles) {
+    // novo índice de cada atirador (-1 se removido) e o índice antigo de quem está em cada posição,
+    // para corrigir o dono dos tiros depois das trocas. só a thread de simulação chama
+    static std::vector<int> shooterRemap;
+    static std::vector<int> shooterOrigin;
+    bool shootersChanged = false;
+
+    std::vector<TargetBody>& shooterBodies = bodies[static_cast<int>(TargetType::Shooter)];
+    shooterRemap.resize(shooterBodies.size());
+    shooterOrigin.resize(shooterBodies.size());
+    for (size_t i = 0; i < shooterBodies.size(); i++) {
+        shooterRemap[i] = shooterOrigin[i] = static_cast<int>(i);
+    }
+
+    for (int t = 0; t < NUM_TARGET_TYPES; t++) {
+        std::vector<TargetBody>& typeBodies = bodies[t];
+        TargetType type = static_cast<TargetType>(t);
+
+        size_t i = 0;
+        while (i < typeBodies.size()) {
+            if (typeBodies[i].active) {
+                i++;
+                continue;
+            }
+
+            // o último vem para o lugar do removido; i é testado de novo
+            size_t last = typeBodies.size() - 1;
+            if (type == TargetType::Shooter) {
+                SimulationTimers().Cancel(shooters[i].cooldownTimer);
+                SimulationTimers().Cancel(shooters[i].burstTimer);
+                int removed = shooterOrigin[i];
+                shooterOrigin[i] = shooterOrigin[last];
+                shooterRemap[shooterOrigin[i]] = static_cast<int>(i);
+                shooterRemap[removed] = -1;
+                shooters[i] = shooters[last];
+                shooters.pop_back();
+                shootersChanged = true;
+            } else if (type == TargetType::Star) {
+                stars[i] = stars[last];
+                stars.pop_back();
+            }
+            typeBodies[i] = typeBodies[last];
+            typeBodies.pop_back();
+        }
+    }
+
+    if (shootersChanged) {
+        projectiles.RemapOwners(ProjectileTeam::Enemy, [](int owner) {
+            int index = IdIndex(owner);
+            if (IdType(owner) != TargetType::Shooter || index < 0 || index >= static_cast<int>(shooterRemap.size())) return -1;
+            int newIndex = shooterRemap[index];
+            return newIndex < 0 ? -1 : MakeId(TargetType::Shooter, newIndex);
+        });
+    }
+}
 
-        // calcula distância até o tanque
-        float distSq = Vector2(dx, dy).lengthSq();
+int TargetSet::Count() const {
+    int count = 0;
+    for (int t = 0; t < NUM_TARGET_TYPES; t++) {
+        count += static_cast<int>(bodies[t].size());
+    }
+    return count;
+}
 
-        // diminui tempo de recarga
-        if (firingCooldown > 0) {
-            firingCooldown--;
+void TargetSet::Update(const Vector2* tankPositions, int numTanks, ProjectileSystem& projectiles,
+                       const BSplineTrack* track, const FlowField* flow) {
+    // guarda o estado do passo anterior para a interpolação da renderização
+    for (int t = 0; t < NUM_TARGET_TYPES; t++) {
+        for (TargetBody& body : bodies[t]) {
+            body.previousPosition = body.position;
         }
+    }
+    if (numTanks <= 0) return;
 
-        // dispara no tanque se estiver no alcance e recarga concluída
-        if (distSq <= shootingRadius * shootingRadius && firingCooldown <= 0) {
-            if (FireAtTarget(tankPosition)) {
-                firingCooldown = firingCooldownReset;
+    // alvos básicos são estacionários
+    UpdateShooters(tankPositions, numTanks, projectiles, track);
+    UpdateStars(tankPositions, numTanks, flow);
+}
+
+void TargetSet::UpdateShooters(const Vector2* tankPositions, int numTanks, ProjectileSystem& projectiles,
+                               const BSplineTrack* track) {
+    std::vector<TargetBody>& shooterBodies = bodies[static_cast<int>(TargetType::Shooter)];
+
+    // atiradores prontos para começar uma rajada e a linha de visada de cada um até o tanque.
+    // só a thread de simulação atualiza os alvos, então o espaço pode ser reaproveitado
+    static std::vector<int> ready;
+    static std::vector<RayQuery> sightLines;
+    ready.clear();
+    sightLines.clear();
+
+    // recargas e intervalos das rajadas vencem sozinhos na roda de timers
+    TimerWheel& timers = SimulationTimers();
+
+    for (size_t i = 0; i < shooterBodies.size(); i++) {
+        TargetBody& body = shooterBodies[i];
+        ShooterState& shooter = shooters[i];
+        if (!body.active) continue;
+
+        // calcula ângulo de mira para o tanque
+        Vector2 tankPosition = ClosestTankPosition(tankPositions, numTanks, body.position);
+        float dx = tankPosition.x - body.position.x;
+        float dy = tankPosition.y - body.position.y;
+        shooter.aimAngle = atan2(dy, dx);
+
+        // rajada em andamento: continua sem olhar a linha de visada de novo
+        if (shooter.burstShotsLeft > 0) {
+            if (timers.IsPending(shooter.burstTimer)) continue;
+            FireShot(static_cast<int>(i), projectiles);
+            if (--shooter.burstShotsLeft > 0) {
+                shooter.burstTimer = timers.Schedule(GetBulletPattern(shooter.pattern).framesBetweenShots);
+            } else {
+                shooter.cooldownTimer = timers.Schedule(shooter.firingCooldownReset);
             }
+            continue;
+        }
+
+        // dispara no tanque se estiver no alcance e recarga concluída
+        float distSq = dx*dx + dy*dy;
+        if (distSq > shooter.shootingRadius * shooter.shootingRadius || timers.IsPending(shooter.cooldownTimer)) continue;
+        if (distSq <= 0.001f) continue;
+
+        ready.push_back(static_cast<int>(i));
+        sightLines.push_back(RayQuery(body.position, tankPosition));
+    }
+
+    // todas as linhas de visada do passo numa consulta só
+    if (track && !sightLines.empty()) {
+        track->rayCast(sightLines.data(), static_cast<int>(sightLines.size()));
+    }
+
+    for (size_t r = 0; r < ready.size(); r++) {
+        if (sightLines[r].hit) continue; // parede no caminho: não atira
+
+        int i = ready[r];
+        ShooterState& shooter = shooters[i];
+        if (!FireShot(i, projectiles)) continue; // sem espaço, tenta no próximo passo
+
+        // o primeiro disparo sai agora; os outros da rajada seguem o intervalo do padrão
+        const BulletPattern& pattern = GetBulletPattern(shooter.pattern);
+        shooter.burstShotsLeft = std::max(0, pattern.shotsPerBurst - 1);
+        if (shooter.burstShotsLeft > 0) {
+            shooter.burstTimer = timers.Schedule(pattern.framesBetweenShots);
+        } else {
+            shooter.cooldownTimer = timers.Schedule(shooter.firingCooldownReset);
         }
+    }
+}
 
-        // atualiza projéteis existentes
-        UpdateProjectiles(track);
+void TargetSet::RefreshCountdowns() {
+    const TimerWheel& timers = SimulationTimers();
+    for (ShooterState& shooter : shooters) {
+        shooter.firingCooldown = timers.Remaining(shooter.cooldownTimer);
     }
-    else if (type == TargetType::Star) {
+}
+
+bool TargetSet::FireShot(int i, ProjectileSystem& projectiles) {
+    const TargetBody& body = bodies[static_cast<int>(TargetType::Shooter)][i];
+    ShooterState& shooter = shooters[i];
+    const BulletPattern& pattern = GetBulletPattern(shooter.pattern);
+
+    float dirX[MAX_BULLETS_PER_SHOT], dirY[MAX_BULLETS_PER_SHOT];
+    int count = EmitPatternDirections(pattern, shooter.aimAngle, shooter.spinAngle, dirX, dirY);
+    shooter.spinAngle = fmodf(shooter.spinAngle + pattern.spinPerShot, 2.0f * static_cast<float>(M_PI));
+
+    // projéteis saem da borda do atirador; tiros inimigos só somem ao bater na pista
+    int owner = MakeId(TargetType::Shooter, i);
+    float spawnDistance = body.radius * 1.5f;
+    bool spawned = false;
+    for (int b = 0; b < count; b++) {
+        Vector2 spawnPos(body.position.x + dirX[b] * spawnDistance, body.position.y + dirY[b] * spawnDistance);
+        Vector2 velocity(dirX[b] * pattern.speed, dirY[b] * pattern.speed);
+        if (projectiles.Spawn(ProjectileTeam::Enemy, owner, spawnPos, velocity,
+                              ProjectileSystem::ENEMY_RADIUS, ProjectileSystem::NO_LIFETIME) < 0) break;
+        spawned = true;
+    }
+    return spawned;
+}
+
+// comportamento de bando das estrelas
+static const float FLOCK_NEIGHBOR_RADIUS = 60.0f;    // vizinhos para alinhamento e coesão
+static const float FLOCK_SEPARATION_RADIUS = 30.0f;  // mais perto que isso se afastam
+static const float FLOCK_SEEK_WEIGHT = 1.0f;
+static const float FLOCK_SEPARATION_WEIGHT = 1.5f;
+static const float FLOCK_ALIGNMENT_WEIGHT = 0.5f;
+static const float FLOCK_COHESION_WEIGHT = 0.3f;
+static const float FLOCK_STEER_BLEND = 0.15f;         // quanto da velocidade desejada entra por passo
+
+// somas dos vizinhos de uma estrela
+struct FlockSums {
+    float separationX, separationY;
+    float velocityX, velocityY;   // dos vizinhos que estão perseguindo
+    float centerX, centerY;
+    int chasingNeighbors;
+};
+
+void TargetSet::UpdateStars(const Vector2* tankPositions, int numTanks, const FlowField* flow) {
+    std::vector<TargetBody>& starBodies = bodies[static_cast<int>(TargetType::Star)];
+    int numStars = static_cast<int>(starBodies.size());
+
+    // grade de vizinhos refeita a cada passo; só a thread de simulação atualiza os alvos
+    static Broadphase neighborGrid;
+    static std::vector<BroadphasePair> neighborPairs;
+    static std::vector<FlockSums> sums;
+    static std::vector<unsigned char> inRange;
+
+    neighborGrid.Clear();
+    inRange.assign(numStars, 0);
+    for (int i = 0; i < numStars; i++) {
+        TargetBody& body = starBodies[i];
+        StarState& star = stars[i];
+        if (!body.active) continue;
+
         // sempre atualiza o ângulo de rotação para efeito giratório
-        rotationAngle += rotationSpeed;
-        if (rotationAngle > 2 * M_PI) {
-            rotationAngle -= 2 * M_PI;
+        star.previousRotationAngle = star.rotationAngle;
+        star.rotationAngle += star.rotationSpeed;
+        if (star.rotationAngle > 2 * M_PI) {
+            star.rotationAngle -= 2 * M_PI;
         }
-        
-        // calcula distância até o tanque
-        float dx = tankPosition.x - position.x;
-        float dy = tankPosition.y - position.y;
-        float distSq = dx*dx + dy*dy;
-        
-        // se estiver dentro do raio de detecção, começa a perseguir
-        if (distSq <= detectionRadius * detectionRadius) {
-            isChasing = true;
-            
-            // calcula direção para o tanque
-            float dist = sqrt(distSq);
-            
-            // só move se não estiver bem em cima do tanque
-            if (dist > 0.1f) {
-                // normaliza e escala pela velocidade
-                float dirX = dx / dist;
-                float dirY = dy / dist;
-                
-                // move em direção ao tanque (mais devagar que antes)
-                position.x += dirX * moveSpeed;
-                position.y += dirY * moveSpeed;
+
+        // dentro do raio de detecção começa a perseguir
+        Vector2 tankPosition = ClosestTankPosition(tankPositions, numTanks, body.position);
+        inRange[i] = body.position.distSq(tankPosition) <= star.detectionRadius * star.detectionRadius;
+
+        // pares a até FLOCK_NEIGHBOR_RADIUS: cada proxy tem metade do raio
+        neighborGrid.Add(body.position.x, body.position.y, FLOCK_NEIGHBOR_RADIUS * 0.5f, 1, 1, i);
+    }
+    neighborGrid.FindPairs(neighborPairs);
+
+    FlockSums zero = {};
+    sums.assign(numStars, zero);
+    for (size_t p = 0; p < neighborPairs.size(); p++) {
+        int a = neighborGrid.GetProxy(neighborPairs[p].a).user;
+        int b = neighborGrid.GetProxy(neighborPairs[p].b).user;
+        const Vector2& pa = starBodies[a].position;
+        const Vector2& pb = starBodies[b].position;
+        float dx = pb.x - pa.x;
+        float dy = pb.y - pa.y;
+        float dist = sqrt(dx*dx + dy*dy);
+
+        // separação: empurra os dois, mais forte quanto mais perto
+        if (dist < FLOCK_SEPARATION_RADIUS && dist > 0.001f) {
+            float push = (1.0f - dist / FLOCK_SEPARATION_RADIUS) / dist;
+            sums[a].separationX -= dx * push;
+            sums[a].separationY -= dy * push;
+            sums[b].separationX += dx * push;
+            sums[b].separationY += dy * push;
+        }
+
+        // alinhamento e coesão só com quem está perseguindo
+        if (inRange[b]) {
+            sums[a].velocityX += stars[b].velocityX;
+            sums[a].velocityY += stars[b].velocityY;
+            sums[a].centerX += pb.x;
+            sums[a].centerY += pb.y;
+            sums[a].chasingNeighbors++;
+        }
+        if (inRange[a]) {
+            sums[b].velocityX += stars[a].velocityX;
+            sums[b].velocityY += stars[a].velocityY;
+            sums[b].centerX += pa.x;
+            sums[b].centerY += pa.y;
+            sums[b].chasingNeighbors++;
+        }
+    }
+
+    for (int i = 0; i < numStars; i++) {
+        TargetBody& body = starBodies[i];
+        StarState& star = stars[i];
+        if (!body.active) continue;
+
+        // persegue se o tanque está no alcance ou se um vizinho do bando está perseguindo
+        const FlockSums& sum = sums[i];
+        if (!inRange[i] && sum.chasingNeighbors == 0) {
+            star.velocityX = star.velocityY = 0.0f;
+            continue;
+        }
+        star.isChasing = true;
+
+        // direção até o tanque: campo de direções pelo corredor ou, na célula do tanque, linha reta
+        Vector2 seek;
+        if (!flow || !flow->SampleDirection(body.position, seek)) {
+            Vector2 tankPosition = ClosestTankPosition(tankPositions, numTanks, body.position);
+            seek.set(tankPosition.x - body.position.x, tankPosition.y - body.position.y);
+            float dist = seek.length();
+            // em cima do tanque não se move
+            if (dist <= 0.1f) continue;
+            seek.set(seek.x / dist, seek.y / dist);
+        }
+
+        float desiredX = seek.x * FLOCK_SEEK_WEIGHT + sum.separationX * FLOCK_SEPARATION_WEIGHT;
+        float desiredY = seek.y * FLOCK_SEEK_WEIGHT + sum.separationY * FLOCK_SEPARATION_WEIGHT;
+        if (sum.chasingNeighbors > 0) {
+            float inv = 1.0f / sum.chasingNeighbors;
+            // alinhamento: velocidade média dos vizinhos, em unidades de moveSpeed
+            if (star.moveSpeed > 0.0f) {
+                desiredX += sum.velocityX * inv / star.moveSpeed * FLOCK_ALIGNMENT_WEIGHT;
+                desiredY += sum.velocityY * inv / star.moveSpeed * FLOCK_ALIGNMENT_WEIGHT;
             }
+            // coesão: em direção ao centro dos vizinhos
+            float toCenterX = sum.centerX * inv - body.position.x;
+            float toCenterY = sum.centerY * inv - body.position.y;
+            float toCenter = sqrt(toCenterX*toCenterX + toCenterY*toCenterY);
+            if (toCenter > 0.001f) {
+                desiredX += toCenterX / toCenter * FLOCK_COHESION_WEIGHT;
+                desiredY += toCenterY / toCenter * FLOCK_COHESION_WEIGHT;
+            }
+        }
+
+        // velocidade desejada sempre com o módulo moveSpeed; a atual muda aos poucos até ela
+        float desiredLength = sqrt(desiredX*desiredX + desiredY*desiredY);
+        if (desiredLength > 0.001f) {
+            desiredX *= star.moveSpeed / desiredLength;
+            desiredY *= star.moveSpeed / desiredLength;
         }
+        star.velocityX += (desiredX - star.velocityX) * FLOCK_STEER_BLEND;
+        star.velocityY += (desiredY - star.velocityY) * FLOCK_STEER_BLEND;
+
+        body.position.x += star.velocityX;
+        body.position.y += star.velocityY;
     }
 }
 
-void Target::Render() {
-    if (!active) return;
-    
-    if (type == TargetType::Basic) {
-        RenderBasicTarget();
-    } else if (type == TargetType::Shooter) {
-        RenderShooterTarget();
-        
-        // renderiza projéteis
-        for (auto& proj : projectiles) {
-            proj.Render();
-        }
-    } else if (type == TargetType::Star) {
-        RenderStarTarget();
+void TargetSet::Render(float alpha, const Camera* view) const {
+    const std::vector<TargetBody>& basicBodies = bodies[static_cast<int>(TargetType::Basic)];
+    for (const TargetBody& body : basicBodies) {
+        if (!body.active) continue;
+        if (view && !view->IsCircleVisible(body.position, body.GetBoundingRadius())) continue;
+
+        // posição interpolada entre os dois últimos passos da simulação
+        Vector2 pos = body.previousPosition.lerp(body.position, alpha);
+        RenderBasicTarget(body, pos);
+        RenderHealthBar(body, pos);
     }
-    
-    // desenha barra de vida para todos os tipos de alvo se health < maxHealth
-    if (health < maxHealth) {
-        float healthRatio = static_cast<float>(health) / maxHealth;
-        float barWidth = radius * 2.0f;
-        float barHeight = 4.0f;
-        float fillWidth = barWidth * healthRatio;
-
-        // fundo da barra de vida
-        CV::color(0.3f, 0.3f, 0.3f);
-        CV::rectFill(position.x - radius, position.y - radius - 10,
-                     position.x - radius + barWidth, position.y - radius - 10 + barHeight);
-
-        // preenchimento da barra de vida
-        CV::color(1.0f - healthRatio, healthRatio, 0.0f); // vermelho para verde
-        CV::rectFill(position.x - radius, position.y - radius - 10,
-                     position.x - radius + fillWidth, position.y - radius - 10 + barHeight);
+
+    const std::vector<TargetBody>& shooterBodies = bodies[static_cast<int>(TargetType::Shooter)];
+    for (size_t i = 0; i < shooterBodies.size(); i++) {
+        const TargetBody& body = shooterBodies[i];
+        if (!body.active) continue;
+        if (view && !view->IsCircleVisible(body.position, body.GetBoundingRadius())) continue;
+
+        Vector2 pos = body.previousPosition.lerp(body.position, alpha);
+        RenderShooterTarget(body, shooters[i], pos);
+        RenderHealthBar(body, pos);
+    }
+
+    const std::vector<TargetBody>& starBodies = bodies[static_cast<int>(TargetType::Star)];
+    for (size_t i = 0; i < starBodies.size(); i++) {
+        const TargetBody& body = starBodies[i];
+        if (!body.active) continue;
+        if (view && !view->IsCircleVisible(body.position, body.GetBoundingRadius())) continue;
+
+        Vector2 pos = body.previousPosition.lerp(body.position, alpha);
+        RenderStarTarget(body, stars[i], pos, InterpolateAngle(stars[i].previousRotationAngle, stars[i].rotationAngle, alpha));
+        RenderHealthBar(body, pos);
     }
 }
 
-void Target::RenderBasicTarget() {
+// desenha barra de vida para todos os tipos de alvo se health < maxHealth
+void TargetSet::RenderHealthBar(const TargetBody& body, const Vector2& pos) {
+    if (body.health >= body.maxHealth) return;
+
+    float radius = body.radius;
+    float healthRatio = static_cast<float>(body.health) / body.maxHealth;
+    float barWidth = radius * 2.0f;
+    float barHeight = 4.0f;
+    float fillWidth = barWidth * healthRatio;
+
+    // fundo da barra de vida
+    CV::color(0.3f, 0.3f, 0.3f);
+    CV::rectFill(pos.x - radius, pos.y - radius - 10,
+                 pos.x - radius + barWidth, pos.y - radius - 10 + barHeight);
+
+    // preenchimento da barra de vida
+    CV::color(1.0f - healthRatio, healthRatio, 0.0f); // vermelho para verde
+    CV::rectFill(pos.x - radius, pos.y - radius - 10,
+                 pos.x - radius + fillWidth, pos.y - radius - 10 + barHeight);
+}
+
+void TargetSet::RenderBasicTarget(const TargetBody& body, const Vector2& pos) {
     // renderização do alvo circular original
-    float healthRatio = static_cast<float>(health) / maxHealth;
+    float healthRatio = static_cast<float>(body.health) / body.maxHealth;
     CV::color(0.8f * healthRatio, 0.3f * healthRatio, 0.0f);
-    CV::circleFill(position.x, position.y, radius, 15);
+    CV::circleFill(pos.x, pos.y, body.radius, 15);
     CV::color(0.4f * healthRatio, 0.15f * healthRatio, 0.0f);
-    CV::circle(position.x, position.y, radius, 15);
+    CV::circle(pos.x, pos.y, body.radius, 15);
 
     // adiciona uma marcação "X" simples
     CV::color(0.2f, 0.2f, 0.2f);
-    CV::line(position.x - radius/1.5f, position.y - radius/1.5f,
-            position.x + radius/1.5f, position.y + radius/1.5f);
-    CV::line(position.x + radius/1.5f, position.y - radius/1.5f,
-            position.x - radius/1.5f, position.y + radius/1.5f);
+    CV::line(pos.x - body.radius/1.5f, pos.y - body.radius/1.5f,
+            pos.x + body.radius/1.5f, pos.y + body.radius/1.5f);
+    CV::line(pos.x + body.radius/1.5f, pos.y - body.radius/1.5f,
+            pos.x - body.radius/1.5f, pos.y + body.radius/1.5f);
 }
 
-void Target::RenderShooterTarget() {
-    // alvo triangular que mira no tanque
-    float size = radius * 1.5f; // um pouco maior que o alvo básico
-
-    // calcula vértices do triângulo
-    float cosA = cos(aimAngle);
-    float sinA = sin(aimAngle);
+void TargetSet::RenderShooterTarget(const TargetBody& body, const ShooterState& shooter, const Vector2& pos) {
+    // alvo triangular que mira no tanque, com os vértices da forma de colisão
+    PolygonShape triangle = ShooterShape(pos, body.radius, shooter);
 
-    // ponto 1: ponto frontal (direcionado ao tanque)
-    float x1 = position.x + cosA * size;
-    float y1 = position.y + sinA * size;
-
-    // pontos 2 e 3: cantos traseiros (perpendiculares à direção de mira)
-    float x2 = position.x - cosA * size * 0.5f + sinA * size * 0.7f;
-    float y2 = position.y - sinA * size * 0.5f - cosA * size * 0.7f;
-    float x3 = position.x - cosA * size * 0.5f - sinA * size * 0.7f;
-    float y3 = position.y - sinA * size * 0.5f + cosA * size * 0.7f;
+    float x1 = triangle.points[0].x, y1 = triangle.points[0].y;
+    float x2 = triangle.points[1].x, y2 = triangle.points[1].y;
+    float x3 = triangle.points[2].x, y3 = triangle.points[2].y;
 
     // desenha o triângulo
     float vx[3] = {x1, x2, x3};
     float vy[3] = {y1, y2, y3};
 
-    float healthRatio = static_cast<float>(health) / maxHealth;
+    float healthRatio = static_cast<float>(body.health) / body.maxHealth;
     CV::color(1.0f * healthRatio, 0.9f * healthRatio, 0.0f); // amarelo
     CV::polygonFill(vx, vy, 3);
 
@@ -164,37 +470,37 @@ void Target::RenderShooterTarget() {
     CV::line(x3, y3, x1, y1);
 
     // desenha indicador de alcance de tiro quando em recarga
-    if (firingCooldown > 0) {
-        float cooldownRatio = static_cast<float>(firingCooldown) / firingCooldownReset;
+    if (shooter.firingCooldown > 0) {
+        float cooldownRatio = static_cast<float>(shooter.firingCooldown) / shooter.firingCooldownReset;
         CV::color(1.0f, 0.0f, 0.0f, 0.3f); // vermelho com transparência
-        CV::circle(position.x, position.y, shootingRadius * cooldownRatio * 0.1f, 30);
+        CV::circle(pos.x, pos.y, shooter.shootingRadius * cooldownRatio * 0.1f, 30);
     }
 }
 
 // renderiza uma forma de estrela com geometria adequada
-void Target::RenderStarTarget() {
+void TargetSet::RenderStarTarget(const TargetBody& body, const StarState& star, const Vector2& pos, float drawRotation) {
     // parâmetros da estrela
-    float outerRadius = radius * 1.5f;
-    float innerRadius = radius * 0.6f;
+    float outerRadius = body.radius * 1.5f;
+    float innerRadius = body.radius * 0.6f;
     const int numPoints = 5;  // estrela de 5 pontas
     
     // precisamos de 10 pontos no total (5 pontos externos e 5 internos)
     Vector2 points[numPoints * 2];
-    float angle = rotationAngle - M_PI/2; 
+    float angle = drawRotation - M_PI/2; 
     
     // desenha pontos em ordem horária, alternando entre pontos externos e internos
     for (int i = 0; i < numPoints * 2; i++) {
         float r = (i % 2 == 0) ? outerRadius : innerRadius;
         
-        points[i].x = position.x + r * cos(angle);
-        points[i].y = position.y + r * sin(angle);
+        points[i].x = pos.x + r * cos(angle);
+        points[i].y = pos.y + r * sin(angle);
         
         angle += M_PI / numPoints;
     }
 
     
     // cor cinza com tom de saúde
-    float healthRatio = static_cast<float>(health) / maxHealth;
+    float healthRatio = static_cast<float>(body.health) / body.maxHealth;
     float shade = 0.5f + 0.3f * (1.0f - healthRatio); // mais escuro quando danificado
     
     // desenha contorno
@@ -205,148 +511,43 @@ void Target::RenderStarTarget() {
     }
     
     // desenha indicador quando está perseguindo
-    if (isChasing) {
+    if (star.isChasing) {
         CV::color(1.0f, 0.2f, 0.2f); // indicador vermelho
-        CV::circleFill(position.x, position.y, radius * 0.3f, 8);
+        CV::circleFill(pos.x, pos.y, body.radius * 0.3f, 8);
     }
 }
 
-bool Target::CheckCollision(const Vector2& point) {
-    if (!active) return false;
-
-    float dx = point.x - position.x;
-    float dy = point.y - position.y;
-    float distanceSquared = dx*dx + dy*dy;
-
-    return distanceSquared <= radius * radius;
+// triângulo apontado para aimAngle, um pouco maior que o alvo básico
+PolygonShape TargetSet::ShooterShape(const Vector2& position, float radius, const ShooterState& shooter) {
+    float size = radius * 1.5f;
+    float cosA = cos(shooter.aimAngle);
+    float sinA = sin(shooter.aimAngle);
+
+    PolygonShape triangle;
+    // ponto frontal (direcionado ao tanque)
+    triangle.Add(position.x + cosA * size, position.y + sinA * size);
+    // cantos traseiros (perpendiculares à direção de mira)
+    triangle.Add(position.x - cosA * size * 0.5f + sinA * size * 0.7f,
+                 position.y - sinA * size * 0.5f - cosA * size * 0.7f);
+    triangle.Add(position.x - cosA * size * 0.5f - sinA * size * 0.7f,
+                 position.y - sinA * size * 0.5f + cosA * size * 0.7f);
+    return triangle;
 }
 
-bool Target::CheckCollisionWithTank(const Vector2& tankPos, float tankWidth, float tankHeight, float tankAngle) {
-    if (!active) return false;
-
-    // converte limites do tanque para coordenadas do mundo
-    float halfW = tankWidth / 2.0f;
-    float halfH = tankHeight / 2.0f;
-    float cosB = cos(tankAngle);
-    float sinB = sin(tankAngle);
-
-    Vector2 localCorners[4] = {
-        Vector2(-halfW, -halfH), Vector2(halfW, -halfH),
-        Vector2(halfW, halfH), Vector2(-halfW, halfH)
-    };
-
-    Vector2 worldCorners[4];
-    for (int i = 0; i < 4; ++i) {
-        worldCorners[i].x = localCorners[i].x * cosB - localCorners[i].y * sinB + tankPos.x;
-        worldCorners[i].y = localCorners[i].x * sinB + localCorners[i].y * cosB + tankPos.y;
-    }
-
-    // verifica se qualquer canto do tanque está dentro do círculo do alvo
-    for (int i = 0; i < 4; ++i) {
-        if (CheckCollision(worldCorners[i])) return true;
-    }
-    
-    // adiciona um ponto extra no centro frontal do tanque para colisao
-    Vector2 frontCenterPoint;
-    Vector2 backCenterPoint;
-    backCenterPoint.x = tankPos.x - halfW * cosB;
-    backCenterPoint.y = tankPos.y - halfW * sinB;
-    frontCenterPoint.x = tankPos.x + halfW * cosB;
-    frontCenterPoint.y = tankPos.y + halfW * sinB;
-    
-    if (CheckCollision(frontCenterPoint)) return true;
-    if (CheckCollision(backCenterPoint)) return true;
+StarShape TargetSet::StarShapeOf(const Vector2& position, float radius, const StarState& star) {
+    return StarShape(position, radius * 1.5f, radius * 0.6f, star.rotationAngle);
+}
 
-    // por simplicidade, estamos mantendo a mesma verificação de colisão para todos os tipos de alvo
-    return false;
+float TargetSet::ShapeRadius(int id) const {
+    const TargetBody& body = Body(id);
+    // triângulo e estrela chegam a 1.5 raio do centro
+    return IdType(id) == TargetType::Basic ? body.radius : body.radius * 1.5f;
 }
 
-void Target::TakeDamage(int amount) {
+void TargetBody::TakeDamage(int amount) {
     health -= amount;
     if (health <= 0) {
         health = 0;
         active = false;
     }
 }
-
-bool Target::FireAtTarget(const Vector2& targetPos) {
-    if (!active || type != TargetType::Shooter) return false;
-
-    // calcula direção do tiro
-    Vector2 direction(targetPos.x - position.x, targetPos.y - position.y);
-    if (direction.lengthSq() > 0.001f) {
-        direction.normalize();
-
-        // cria projétil com velocidade apropriada
-        float bulletSpeed = 2.5f; // um pouco mais rápido para melhor desafio
-        Vector2 bulletVelocity = direction * bulletSpeed;
-
-        // gera projétil a partir da ponta do triângulo (ponto frontal)
-        Vector2 spawnPos = position + direction * (radius * 1.5f);
-        EnemyProjectile bullet(spawnPos, bulletVelocity);
-
-        // adiciona à lista de projéteis
-        projectiles.push_back(bullet);
-        return true;
-    }
-
-    return false;
-}
-
-void Target::UpdateProjectiles(BSplineTrack* track) {
-    // atualiza cada projétil
-    for (auto& proj : projectiles) {
-        if (proj.active) {
-            proj.Update();
-
-            // verifica colisão com parede se o track for fornecido
-            if (track) {
-                proj.CheckCollisionWithTrack(track);
-            }
-        }
-    }
-
-    // remove projéteis inativos
-    projectiles.erase(
-        std::remove_if(
-            projectiles.begin(),
-            projectiles.end(),
-            [](const EnemyProjectile& p) { return !p.active; }
-        ),
-        projectiles.end()
-    );
-}
-
-bool EnemyProjectile::CheckCollisionWithTrack(BSplineTrack* track) {
-    if (!active || !track) return false;
-
-    // obtém pontos mais próximos em ambos os limites da pista
-    ClosestPointInfo cpiLeft = track->findClosestPointOnCurve(position, CurveSide::Left);
-    ClosestPointInfo cpiRight = track->findClosestPointOnCurve(position, CurveSide::Right);
-
-    // verifica colisão com limite esquerdo
-    if (cpiLeft.isValid) {
-        Vector2 vec_proj_to_cl_point = position - cpiLeft.point;
-        float projection = vec_proj_to_cl_point.x * cpiLeft.normal.x + vec_proj_to_cl_point.y * cpiLeft.normal.y;
-
-        // se a projeção for positiva, o projétil está fora do limite esquerdo
-        if (projection > 0.0f && projection < radius) {
-            active = false;
-            return true;
-        }
-    }
-
-    // verifica colisão com limite direito
-    if (cpiRight.isValid) {
-        Vector2 vec_proj_to_cr_point = position - cpiRight.point;
-        float projection = vec_proj_to_cr_point.x * cpiRight.normal.x + vec_proj_to_cr_point.y * cpiRight.normal.y;
-
-        // se a projeção for negativa, o projétil está fora do limite direito
-        if (projection < 0.0f && std::abs(projection) < radius) {
-            active = false;
-            return true;
-        }
-    }
-
-    return false;
-}
@@ -1,8 +1,14 @@
 /**
  * Target.h
- * Define as classes relacionadas aos alvos/inimigos do jogo.
- * Inclui diferentes tipos de alvos (básico, atirador e estrela) 
- * e implementa projéteis inimigos com seus comportamentos específicos.
+ * Define o armazenamento dos alvos/inimigos do jogo.
+ * Inclui diferentes tipos de alvos (básico, atirador e estrela).
+ * Cada tipo tem seu próprio array denso: os campos usados por todos
+ * (posição, raio, vida) ficam separados dos dados de comportamento de cada tipo,
+ * e a atualização roda um laço por tipo, sem testar o tipo elemento a elemento.
+ * Alvos destruídos saem dos arrays no fim de cada passo (RemoveInactive).
+ * Os tiros dos atiradores ficam no sistema de projéteis, marcados com o id do alvo,
+ * e seguem o padrão de tiro (BulletPattern) de cada atirador.
+ * As estrelas perseguem em bando (separação, alinhamento e coesão com os vizinhos).
  */
 
 #ifndef __TARGET_H__
@@ -10,41 +16,16 @@
 
 #include "Vector2.h"
 #include "gl_canvas2d.h"
+#include "Camera.h"
+#include "ShapeCollision.h"
+#include "TimerWheel.h"
 #include <cmath>
-#include <algorithm> 
-#include <vector>   
+#include <algorithm>
+#include <vector>
 
-// declaração antecipada para detecção de colisão
+class ProjectileSystem;
 class BSplineTrack;
-
-// define uma classe para projéteis inimigos
-class EnemyProjectile {
-public:
-    Vector2 position;
-    Vector2 velocity;
-    bool active;
-    float radius;
-    
-    EnemyProjectile() : active(false), radius(5.0f) {}
-    
-    EnemyProjectile(const Vector2& pos, const Vector2& vel) 
-        : position(pos), velocity(vel), active(true), radius(5.0f) {}
-    
-    void Update() {
-        if (!active) return;
-        position = position + velocity;
-    }
-    
-    void Render() {
-        if (!active) return;
-        CV::color(1.0f, 0.5f, 0.0f); // laranja brilhante para melhor visibilidade
-        CV::circleFill(position.x, position.y, radius, 8);
-        CV::color(1.0f, 0.2f, 0.0f); // contorno vermelho
-        CV::circle(position.x, position.y, radius, 8);
-    }
-    
-    bool CheckCollisionWithTrack(BSplineTrack* track);
-};
+class FlowField;
 
 // define tipos de alvos
 enum class TargetType {
@@ -53,44 +34,145 @@ enum class TargetType {
     Star = 2      // estrela que persegue o tanque quando está ao alcance
 };
 
-class Target {
-public:
+static const int NUM_TARGET_TYPES = 3;
+
+// campos quentes, lidos por colisão, culling e minimapa em todos os tipos
+struct TargetBody {
     Vector2 position;
-    bool active;
+    Vector2 previousPosition;      // posição do passo anterior para interpolação
     float radius;
     int health;        // pontos de vida
     int maxHealth;     // vida máxima
-    TargetType type;   // tipo de alvo
-    
-    // propriedades específicas do atirador
+    bool active;
+
+    TargetBody(const Vector2& pos)
+        : position(pos), previousPosition(pos), radius(12.0f), health(2), maxHealth(2), active(true) {}
+
+    void TakeDamage(int amount);
+
+    // raio que envolve o desenho do alvo (estrela, triângulo e barra de vida)
+    float GetBoundingRadius() const { return radius * 1.5f + 10.0f; }
+};
+
+// propriedades específicas do atirador
+struct ShooterState {
     float aimAngle;                // ângulo em que o atirador está mirando
     float shootingRadius;          // alcance dentro do qual o atirador dispara
-    int firingCooldown;            // temporizador de recarga atual
-    int firingCooldownReset;       // tempo entre disparos
-    std::vector<EnemyProjectile> projectiles; // projéteis inimigos
-    
-    // propriedades específicas da estrela
+    TimerHandle cooldownTimer;     // recarga entre rajadas, na roda de timers
+    int firingCooldown;            // o que falta da recarga, para o desenho (ver RefreshCountdowns)
+    int firingCooldownReset;       // tempo entre rajadas
+    int pattern;                   // índice na tabela de padrões de tiro
+    int burstShotsLeft;            // disparos que faltam na rajada atual
+    TimerHandle burstTimer;        // próximo disparo da rajada
+    float spinAngle;               // giro acumulado dos padrões em espiral
+
+    ShooterState() : aimAngle(0.0f), shootingRadius(200.0f), firingCooldown(0), firingCooldownReset(90),
+                     pattern(0), burstShotsLeft(0), spinAngle(0.0f) {}
+};
+
+// propriedades específicas da estrela
+struct StarState {
     float detectionRadius;    // alcance dentro do qual a estrela começa a perseguir
     float moveSpeed;          // velocidade de movimento da estrela
     bool isChasing;           // se a estrela está perseguindo o tanque
     float rotationAngle;      // ângulo de rotação atual da estrela
+    float previousRotationAngle;
     float rotationSpeed;      // velocidade de rotação da estrela
-    
-    Target();
-    Target(const Vector2& pos, TargetType targetType = TargetType::Basic);
-
-    void Update(const Vector2& tankPosition, BSplineTrack* track);
-    void Render();
-    bool CheckCollision(const Vector2& point);
-    bool CheckCollisionWithTank(const Vector2& tankPos, float tankWidth, float tankHeight, float tankAngle);
-    void TakeDamage(int amount);
-    bool FireAtTarget(const Vector2& targetPos);
+    float velocityX, velocityY; // velocidade atual, suavizada pelo comportamento de bando
+
+    StarState() : detectionRadius(200.0f), moveSpeed(0.8f), isChasing(false),
+                  rotationAngle(0.0f), previousRotationAngle(0.0f), rotationSpeed(0.05f),
+                  velocityX(0.0f), velocityY(0.0f) {}
+};
+
+class TargetSet {
+public:
+    // um array denso por tipo; shooters e stars andam em paralelo com bodies do mesmo tipo
+    std::vector<TargetBody> bodies[NUM_TARGET_TYPES];
+    std::vector<ShooterState> shooters;
+    std::vector<StarState> stars;
+
+    // id de um alvo: tipo nos 2 bits de baixo e índice no array do tipo no resto
+    static int MakeId(TargetType type, int index) { return (index << 2) | static_cast<int>(type); }
+    static TargetType IdType(int id) { return static_cast<TargetType>(id & 3); }
+    static int IdIndex(int id) { return id >> 2; }
+
+    bool IsValid(int id) const;
+    TargetBody& Body(int id) { return bodies[id & 3][id >> 2]; }
+    const TargetBody& Body(int id) const { return bodies[id & 3][id >> 2]; }
+
+    // cria um alvo com os valores padrão do tipo; retorna o id
+    int Add(const Vector2& position, TargetType type);
+
+    // esvazia mantendo a memória já reservada
+    void Clear();
+
+    // tira os alvos inativos trazendo o último do array para o lugar de cada um. os ids mudam:
+    // tiros de atiradores removidos somem e os dos atiradores movidos passam para o novo id
+    void RemoveInactive(ProjectileSystem& projectiles);
+    int Count() const;
+
+    // chama f(id, body) para todos os alvos
+    template <typename F>
+    void ForEach(F f) {
+        for (int t = 0; t < NUM_TARGET_TYPES; t++) {
+            for (size_t i = 0; i < bodies[t].size(); i++) f(MakeId(static_cast<TargetType>(t), static_cast<int>(i)), bodies[t][i]);
+        }
+    }
+
+    template <typename F>
+    void ForEach(F f) const {
+        for (int t = 0; t < NUM_TARGET_TYPES; t++) {
+            for (size_t i = 0; i < bodies[t].size(); i++) f(MakeId(static_cast<TargetType>(t), static_cast<int>(i)), bodies[t][i]);
+        }
+    }
+
+    // forma exata de colisão de cada tipo, a mesma do desenho
+    static PolygonShape ShooterShape(const Vector2& position, float radius, const ShooterState& shooter);
+    static StarShape StarShapeOf(const Vector2& position, float radius, const StarState& star);
+
+    // raio do círculo que envolve a forma de colisão do alvo
+    float ShapeRadius(int id) const;
+
+    // teste exato entre o alvo e uma forma; o tipo do alvo escolhe a forma dele
+    template <typename S>
+    bool Overlaps(int id, const S& shape) const {
+        const TargetBody& body = Body(id);
+        if (!body.active) return false;
+
+        switch (IdType(id)) {
+        case TargetType::Shooter:
+            return ShapesOverlap(ShooterShape(body.position, body.radius, shooters[IdIndex(id)]), shape);
+        case TargetType::Star:
+            return ShapesOverlap(StarShapeOf(body.position, body.radius, stars[IdIndex(id)]), shape);
+        default:
+            return ShapesOverlap(CircleShape(body.position, body.radius), shape);
+        }
+    }
+
+    // cada alvo reage ao tanque mais próximo; atiradores só disparam com linha de visada livre na pista
+    // e estrelas perseguem seguindo o campo de direções
+    void Update(const Vector2* tankPositions, int numTanks, ProjectileSystem& projectiles,
+                const BSplineTrack* track = nullptr, const FlowField* flow = nullptr);
+
+    // copia o que falta em cada timer para os contadores lidos pelo desenho
+    void RefreshCountdowns();
+
+    // com uma câmera, os alvos fora da tela não são desenhados
+    void Render(float alpha = 1.0f, const Camera* view = nullptr) const;
 
 private:
-    void RenderBasicTarget();
-    void RenderShooterTarget();
-    void RenderStarTarget();
-    void UpdateProjectiles(BSplineTrack* track);
+    void UpdateShooters(const Vector2* tankPositions, int numTanks, ProjectileSystem& projectiles,
+                        const BSplineTrack* track);
+    void UpdateStars(const Vector2* tankPositions, int numTanks, const FlowField* flow);
+
+    // um disparo do padrão do atirador i; retorna false se não coube nenhum projétil
+    bool FireShot(int i, ProjectileSystem& projectiles);
+
+    static void RenderBasicTarget(const TargetBody& body, const Vector2& pos);
+    static void RenderShooterTarget(const TargetBody& body, const ShooterState& shooter, const Vector2& pos);
+    static void RenderStarTarget(const TargetBody& body, const StarState& star, const Vector2& pos, float drawRotation);
+    static void RenderHealthBar(const TargetBody& body, const Vector2& pos);
 };
 
 #endif
@@ -0,0 +1,165 @@
+/**
+ * TimerWheel.cpp
+ * Implementa a roda de timers: listas duplamente ligadas por posição,
+ * com os nós num vetor reaproveitado por uma lista livre.
+ */
+
+#include "TimerWheel.h"
+#include <algorithm>
+
+const int TimerWheel::MAX_DELAY;
+
+TimerWheel::TimerWheel() : currentStep(0), pendingCount(0) {
+    std::fill(heads, heads + NUM_BUCKETS + 1, -1);
+}
+
+TimerWheel& SimulationTimers() {
+    static TimerWheel timers;
+    return timers;
+}
+
+TimerHandle TimerWheel::Schedule(int delaySteps, TimerCallback callback, void* context, int user) {
+    delaySteps = std::max(1, std::min(delaySteps, MAX_DELAY));
+
+    int node;
+    if (!freeNodes.empty()) {
+        node = freeNodes.back();
+        freeNodes.pop_back();
+    } else {
+        node = static_cast<int>(nodes.size());
+        Node empty = {};
+        nodes.push_back(empty);
+    }
+
+    Node& n = nodes[node];
+    // o próximo Advance processa currentStep, então um passo de atraso vence nele
+    n.expires = currentStep + static_cast<unsigned int>(delaySteps) - 1;
+    n.callback = callback;
+    n.context = context;
+    n.user = user;
+    Insert(node);
+    pendingCount++;
+
+    TimerHandle handle;
+    handle.index = node;
+    handle.generation = n.generation;
+    return handle;
+}
+
+void TimerWheel::Restart(TimerHandle& handle, int delaySteps, TimerCallback callback, void* context, int user) {
+    Cancel(handle);
+    handle = Schedule(delaySteps, callback, context, user);
+}
+
+bool TimerWheel::Cancel(TimerHandle& handle) {
+    bool pending = IsPending(handle);
+    if (pending) {
+        Unlink(handle.index);
+        Release(handle.index);
+    }
+    handle = TimerHandle();
+    return pending;
+}
+
+bool TimerWheel::IsPending(const TimerHandle& handle) const {
+    if (handle.index < 0 || handle.index >= static_cast<int>(nodes.size())) return false;
+    const Node& n = nodes[handle.index];
+    return n.generation == handle.generation && n.bucket >= 0;
+}
+
+int TimerWheel::Remaining(const TimerHandle& handle) const {
+    if (!IsPending(handle)) return 0;
+    return static_cast<int>(nodes[handle.index].expires - currentStep) + 1;
+}
+
+void TimerWheel::Advance() {
+    unsigned int step = currentStep;
+
+    // o nível 0 deu a volta: desce os timers da posição atual dos níveis de cima
+    for (int level = 1; level < LEVELS; level++) {
+        if (((step >> (SLOT_BITS * (level - 1))) & (SLOTS - 1)) != 0) break;
+        Cascade(level);
+    }
+
+    // passa os vencidos para a lista de disparo antes dos callbacks: eles podem
+    // agendar timers novos ou cancelar os que ainda não foram chamados
+    int bucket = step & (SLOTS - 1);
+    heads[FIRING_BUCKET] = heads[bucket];
+    heads[bucket] = -1;
+    for (int node = heads[FIRING_BUCKET]; node >= 0; node = nodes[node].next) {
+        nodes[node].bucket = FIRING_BUCKET;
+    }
+    currentStep++;
+
+    while (heads[FIRING_BUCKET] >= 0) {
+        int node = heads[FIRING_BUCKET];
+        Unlink(node);
+        TimerCallback callback = nodes[node].callback;
+        void* context = nodes[node].context;
+        int user = nodes[node].user;
+        Release(node);
+
+        if (callback) callback(context, user);
+    }
+}
+
+void TimerWheel::Clear() {
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (nodes[i].bucket >= 0) Release(static_cast<int>(i));
+    }
+    std::fill(heads, heads + NUM_BUCKETS + 1, -1);
+}
+
+void TimerWheel::Insert(int node) {
+    unsigned int delta = nodes[node].expires - currentStep;
+
+    // menor nível cujo alcance cobre o atraso; a posição vem dos bits do passo de vencimento
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (1u << (SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    int slot = (nodes[node].expires >> (SLOT_BITS * level)) & (SLOTS - 1);
+    Link(node, level * SLOTS + slot);
+}
+
+void TimerWheel::Link(int node, int bucket) {
+    Node& n = nodes[node];
+    n.bucket = bucket;
+    n.prev = -1;
+    n.next = heads[bucket];
+    if (n.next >= 0) nodes[n.next].prev = node;
+    heads[bucket] = node;
+}
+
+void TimerWheel::Unlink(int node) {
+    Node& n = nodes[node];
+    if (n.prev >= 0) {
+        nodes[n.prev].next = n.next;
+    } else if (heads[n.bucket] == node) {
+        heads[n.bucket] = n.next;
+    }
+    if (n.next >= 0) nodes[n.next].prev = n.prev;
+    n.prev = n.next = -1;
+}
+
+void TimerWheel::Release(int node) {
+    Node& n = nodes[node];
+    n.bucket = -1;
+    n.callback = nullptr;
+    n.context = nullptr;
+    n.generation++; // handles antigos deixam de valer
+    freeNodes.push_back(node);
+    pendingCount--;
+}
+
+void TimerWheel::Cascade(int level) {
+    int bucket = level * SLOTS + ((currentStep >> (SLOT_BITS * level)) & (SLOTS - 1));
+    int node = heads[bucket];
+    heads[bucket] = -1;
+
+    while (node >= 0) {
+        int next = nodes[node].next;
+        Insert(node);
+        node = next;
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * TimerWheel.h
+ * Roda de timers hierárquica para as contagens regressivas da simulação
+ * (recarga, invulnerabilidade, tempo de vida dos tiros, efeitos de power-up).
+ * Cada nível tem 64 posições; o nível 0 avança um passo por vez e os de cima
+ * só são redistribuídos quando o de baixo dá a volta. Avançar um passo custa
+ * o número de timers que vencem (mais as redistribuições), não o número de
+ * timers pendentes. Agendar e cancelar são O(1).
+ */
+
+#ifndef __TIMER_WHEEL_H__
+#define __TIMER_WHEEL_H__
+
+#include <vector>
+
+// chamada quando o timer vence; user é o valor passado ao agendar
+typedef void (*TimerCallback)(void* context, int user);
+
+// referência a um timer agendado; continua segura depois que ele vence ou é cancelado
+struct TimerHandle {
+    int index;
+    unsigned int generation;
+
+    TimerHandle() : index(-1), generation(0) {}
+};
+
+class TimerWheel {
+public:
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const int LEVELS = 4;
+    static const int MAX_DELAY = (1 << (SLOT_BITS * LEVELS)) - 1; // passos
+
+    TimerWheel();
+
+    // vence daqui a delaySteps passos (mínimo 1: no próximo Advance).
+    // sem callback o timer serve só como flag, consultada por IsPending
+    TimerHandle Schedule(int delaySteps, TimerCallback callback = nullptr, void* context = nullptr, int user = 0);
+
+    // cancela o timer anterior do handle (se houver) e agenda de novo
+    void Restart(TimerHandle& handle, int delaySteps, TimerCallback callback = nullptr,
+                 void* context = nullptr, int user = 0);
+
+    // retorna se havia um timer pendente; o handle fica inválido
+    bool Cancel(TimerHandle& handle);
+
+    bool IsPending(const TimerHandle& handle) const;
+
+    // passos até vencer (0 se não está pendente)
+    int Remaining(const TimerHandle& handle) const;
+
+    // avança um passo e chama os callbacks dos timers que venceram
+    void Advance();
+
+    unsigned int GetStep() const { return currentStep; }
+    int GetPendingCount() const { return pendingCount; }
+
+    // descarta todos os timers sem chamar os callbacks
+    void Clear();
+
+private:
+    struct Node {
+        unsigned int expires;   // passo em que vence
+        TimerCallback callback;
+        void* context;
+        int user;
+        unsigned int generation;
+        int prev, next;
+        int bucket;             // lista em que está (-1 se livre)
+    };
+
+    static const int NUM_BUCKETS = LEVELS * SLOTS;
+    static const int FIRING_BUCKET = NUM_BUCKETS; // timers vencidos esperando o callback
+
+    std::vector<Node> nodes;
+    std::vector<int> freeNodes;
+    int heads[NUM_BUCKETS + 1];
+    unsigned int currentStep;   // próximo passo a ser processado
+    int pendingCount;
+
+    void Insert(int node);
+    void Link(int node, int bucket);
+    void Unlink(int node);
+    void Release(int node);
+    void Cascade(int level);
+};
+
+// roda compartilhada pelos sistemas do jogo; só a thread de simulação usa
+TimerWheel& SimulationTimers();
+
+#endif
@@ -0,0 +1,170 @@
+/**
+ * TrackShader.cpp
+ * Implementa a avaliação da B-Spline da pista no vertex shader.
+ */
+
+#include "TrackShader.h"
+#include "BSplineTrack.h"
+#include "GLExtensions.h"
+#include <algorithm>
+
+const int TrackShader::MAX_POINTS_PER_CURVE;
+
+// os pontos das duas bordas ficam no mesmo vetor: esquerda em [0, 20) e direita em [20, 40)
+static const char* TRACK_VERTEX_SHADER =
+    "#version 110\n"
+    "uniform vec2 points[40];\n"
+    "uniform vec2 counts;\n"       // pontos de controle da esquerda e da direita
+    "uniform float closedLoop;\n"  // 1 = pista fechada
+    "uniform float perSegment;\n"  // 1 = x é segmento + t local; 0 = x é o t global (0 a 1)
+    "vec2 evalCurve(int base, float count, float u)\n"
+    "{\n"
+    "    float segments = closedLoop > 0.5 ? count : count - 3.0;\n"
+    "    float s = perSegment > 0.5 ? u : u * segments;\n"
+    "    float seg = clamp(floor(s), 0.0, segments - 1.0);\n"
+    "    float t = s - seg;\n"
+    "    float t2 = t * t;\n"
+    "    float t3 = t2 * t;\n"
+    "    vec4 b = vec4((1.0 - t) * (1.0 - t) * (1.0 - t),\n"
+    "                  3.0 * t3 - 6.0 * t2 + 4.0,\n"
+    "                  -3.0 * t3 + 3.0 * t2 + 3.0 * t + 1.0,\n"
+    "                  t3) / 6.0;\n"
+    "    vec4 idx = seg + vec4(0.0, 1.0, 2.0, 3.0);\n"
+    "    if (closedLoop > 0.5) idx = mod(idx, count);\n"
+    "    return points[base + int(idx.x)] * b.x + points[base + int(idx.y)] * b.y +\n"
+    "           points[base + int(idx.z)] * b.z + points[base + int(idx.w)] * b.w;\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "    vec2 left = evalCurve(0, counts.x, gl_Vertex.x);\n"
+    "    vec2 right = evalCurve(20, counts.y, gl_Vertex.x);\n"
+    "    gl_Position = gl_ModelViewProjectionMatrix * vec4(mix(left, right, gl_Vertex.y), 0.0, 1.0);\n"
+    "    gl_FrontColor = gl_Color;\n"
+    "}\n";
+
+static const char* TRACK_FRAGMENT_SHADER =
+    "#version 110\n"
+    "void main()\n"
+    "{\n"
+    "    gl_FragColor = gl_Color;\n"
+    "}\n";
+
+TrackShader::TrackShader()
+    : program(0), programTried(false), locPoints(-1), locCounts(-1), locClosedLoop(-1), locPerSegment(-1),
+      uploadedRevision(0), uploaded(false), fillSteps(0), stepsPerSegment(0) {}
+
+bool TrackShader::EnsureProgram() {
+    if (program) return true;
+    if (programTried) return false;
+    programTried = true;
+
+    program = GLExt::BuildProgram(TRACK_VERTEX_SHADER, TRACK_FRAGMENT_SHADER);
+    if (!program) return false;
+
+    locPoints = GLExt::GetUniformLocation(program, "points");
+    locCounts = GLExt::GetUniformLocation(program, "counts");
+    locClosedLoop = GLExt::GetUniformLocation(program, "closedLoop");
+    locPerSegment = GLExt::GetUniformLocation(program, "perSegment");
+    return true;
+}
+
+// mesma densidade de amostras do caminho da CPU (BSplineTrack::GetGeometry)
+void TrackShader::BuildParameters(int newFillSteps, int newStepsPerSegment) {
+    fillSteps = newFillSteps;
+    stepsPerSegment = newStepsPerSegment;
+
+    fillStrip.clear();
+    centerDashes.clear();
+    for (int i = 0; i <= fillSteps; ++i) {
+        float t = static_cast<float>(i) / fillSteps;
+        fillStrip.push_back({ t, 0.0f });
+        fillStrip.push_back({ t, 1.0f });
+    }
+    for (int j = 0; j < fillSteps; ++j) {
+        if (j % 4 >= 2) continue; // espaço entre traços
+        centerDashes.push_back({ static_cast<float>(j) / fillSteps, 0.5f });
+        centerDashes.push_back({ static_cast<float>(j + 1) / fillSteps, 0.5f });
+    }
+
+    // bordas: parâmetro = segmento + t local, para o máximo de segmentos possível
+    outlineLeft.clear();
+    outlineRight.clear();
+    int maxSteps = MAX_POINTS_PER_CURVE * stepsPerSegment;
+    for (int i = 0; i <= maxSteps; ++i) {
+        float u = static_cast<float>(i) / stepsPerSegment;
+        outlineLeft.push_back({ u, 0.0f });
+        outlineRight.push_back({ u, 1.0f });
+    }
+}
+
+void TrackShader::UploadControlPoints(const BSplineTrack& track) {
+    float points[MAX_POINTS_PER_CURVE * 2 * 2] = {};
+    int leftCount = std::min(static_cast<int>(track.controlPointsLeft.size()), MAX_POINTS_PER_CURVE);
+    int rightCount = std::min(static_cast<int>(track.controlPointsRight.size()), MAX_POINTS_PER_CURVE);
+    for (int i = 0; i < leftCount; ++i) {
+        points[i * 2] = track.controlPointsLeft[i].x;
+        points[i * 2 + 1] = track.controlPointsLeft[i].y;
+    }
+    for (int i = 0; i < rightCount; ++i) {
+        points[(MAX_POINTS_PER_CURVE + i) * 2] = track.controlPointsRight[i].x;
+        points[(MAX_POINTS_PER_CURVE + i) * 2 + 1] = track.controlPointsRight[i].y;
+    }
+
+    GLExt::Uniform2fv(locPoints, MAX_POINTS_PER_CURVE * 2, points);
+    GLExt::Uniform2f(locCounts, static_cast<float>(leftCount), static_cast<float>(rightCount));
+    GLExt::Uniform1f(locClosedLoop, track.loop ? 1.0f : 0.0f);
+
+    uploadedRevision = track.revision;
+    uploaded = true;
+}
+
+bool TrackShader::Render(const BSplineTrack& track, float detail) {
+    if (!EnsureProgram()) return false;
+
+    const int fill_steps = std::max(20, static_cast<int>(100 * detail));
+    const int steps_per_segment = std::max(4, static_cast<int>(20 * detail));
+    if (fill_steps != fillSteps || steps_per_segment != stepsPerSegment) {
+        BuildParameters(fill_steps, steps_per_segment);
+    }
+
+    GLExt::UseProgram(program);
+    if (!uploaded || uploadedRevision != track.revision) {
+        UploadControlPoints(track);
+    }
+
+    int leftCount = static_cast<int>(track.controlPointsLeft.size());
+    int rightCount = static_cast<int>(track.controlPointsRight.size());
+    int minPoints = track.MIN_CONTROL_POINTS_PER_CURVE;
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+
+    // superfície e faixa central usam o t global nas duas bordas
+    if (leftCount >= minPoints && rightCount >= minPoints) {
+        GLExt::Uniform1f(locPerSegment, 0.0f);
+
+        glColor3f(0.5f, 0.5f, 0.5f);
+        glVertexPointer(2, GL_FLOAT, sizeof(ParamVertex), &fillStrip[0].u);
+        glDrawArrays(GL_QUAD_STRIP, 0, static_cast<GLsizei>(fillStrip.size()));
+
+        glColor3f(1.0f, 1.0f, 0.0f);
+        glVertexPointer(2, GL_FLOAT, sizeof(ParamVertex), &centerDashes[0].u);
+        glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(centerDashes.size()));
+    }
+
+    // bordas: só os vértices dos segmentos que existem em cada uma
+    GLExt::Uniform1f(locPerSegment, 1.0f);
+    glColor3f(0.1f, 0.1f, 0.4f);
+    const std::vector<ParamVertex>* outlines[2] = { &outlineLeft, &outlineRight };
+    int counts[2] = { leftCount, rightCount };
+    for (int side = 0; side < 2; ++side) {
+        if (counts[side] < minPoints) continue;
+        int segments = track.loop ? counts[side] : counts[side] - track.degree;
+        if (segments <= 0) continue;
+        glVertexPointer(2, GL_FLOAT, sizeof(ParamVertex), &(*outlines[side])[0].u);
+        glDrawArrays(GL_LINE_STRIP, 0, segments * stepsPerSegment + 1);
+    }
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+    GLExt::UseProgram(0);
+    return true;
+}
@@ -0,0 +1,54 @@
+/**
+ * TrackShader.h
+ * Caminho de renderização da pista avaliado na GPU.
+ * Os pontos de controle das duas bordas vão para um vetor uniforme e o
+ * vertex shader calcula a B-Spline a partir de parâmetros fixos (t e lado),
+ * então editar um ponto só exige reenviar os pontos de controle.
+ */
+
+#ifndef __TRACK_SHADER_H__
+#define __TRACK_SHADER_H__
+
+#include <vector>
+
+class BSplineTrack;
+
+class TrackShader {
+public:
+    static const int MAX_POINTS_PER_CURVE = 20; // igual a BSplineTrack::MAX_CONTROL_POINTS
+
+    TrackShader();
+
+    // desenha superfície, faixa central e bordas da pista.
+    // retorna false se não há shaders (o chamador deve usar BSplineTrack::Render)
+    bool Render(const BSplineTrack& track, float detail);
+
+private:
+    // vértice de parâmetros: x = t (global ou segmento + t local), y = lado (0 esquerda, 1 direita, 0.5 centro)
+    struct ParamVertex {
+        float u;
+        float side;
+    };
+
+    unsigned int program;
+    bool programTried;
+
+    int locPoints, locCounts, locClosedLoop, locPerSegment;
+
+    unsigned int uploadedRevision; // revisão da pista cujos pontos estão nos uniformes
+    bool uploaded;
+
+    // parâmetros fixos, refeitos só quando a densidade muda
+    int fillSteps;
+    int stepsPerSegment;
+    std::vector<ParamVertex> fillStrip;
+    std::vector<ParamVertex> centerDashes;
+    std::vector<ParamVertex> outlineLeft;
+    std::vector<ParamVertex> outlineRight;
+
+    bool EnsureProgram();
+    void BuildParameters(int newFillSteps, int newStepsPerSegment);
+    void UploadControlPoints(const BSplineTrack& track);
+};
+
+#endif
@@ -54,6 +54,12 @@ public:
        return Vector2(x / l, y / l);
    }
 
+   // interpolacao linear entre este vetor (t = 0) e outro (t = 1)
+   Vector2 lerp(const Vector2& other, float t) const
+   {
+       return Vector2(x + (other.x - x) * t, y + (other.y - y) * t);
+   }
+
    void normalize()
    {
        float norm = (float)sqrt(x*x + y*y);
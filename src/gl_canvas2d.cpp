@@ -14,10 +14,100 @@
 
 
 #include "gl_canvas2d.h"
+#include "GLExtensions.h"
 #include <GL/glut.h>
+#include <atomic>
 
 int *scrWidth, *scrHeight;
 
+#ifndef GL_MULTISAMPLE
+#define GL_MULTISAMPLE 0x809D
+#endif
+
+//fracao dos lados usados nos circulos, ajustada pelo controle de qualidade
+static float circleDetailScale = 1.0f;
+
+//textura usada para ampliar o mundo desenhado em resolucao reduzida
+static GLuint scaledTexture = 0;
+static int scaledTextureW = 0, scaledTextureH = 0;
+static float activeRenderScale = 1.0f;
+
+//politica de redesenho (ver CV::continuousRedraw)
+static std::atomic<bool> continuousRedrawEnabled(true);
+static std::atomic<bool> redrawRequested(true);
+static bool pointerInside = true;   //mouse dentro da janela (usado como foco)
+static bool windowVisible = true;
+static bool idleRedrawInstalled = false;
+static const int REDRAW_POLL_MS = 15;       //checagem dos pedidos de redesenho
+static const int INACTIVE_FRAME_MS = 100;   //janela sem foco: ~10 quadros por segundo
+
+//circulos por distancia com sinal (SDF): um quad por circulo e a borda suavizada no fragment shader.
+//coordenada de textura: xy = posicao relativa ao centro, z = raio, w = espessura do anel em pixels (0 = cheio)
+static const char *CIRCLE_VERTEX_SHADER =
+   "#version 110\n"
+   "void main()\n"
+   "{\n"
+   "   gl_Position = ftransform();\n"
+   "   gl_FrontColor = gl_Color;\n"
+   "   gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+   "}\n";
+
+static const char *CIRCLE_FRAGMENT_SHADER =
+   "#version 110\n"
+   "void main()\n"
+   "{\n"
+   "   vec4 c = gl_TexCoord[0];\n"
+   "   float d = length(c.xy);\n"
+   "   float aa = max(fwidth(d), 0.0001);\n" //tamanho de um pixel em unidades do mundo
+   "   float a = 1.0 - smoothstep(c.z - aa, c.z, d);\n"
+   "   if( c.w > 0.0 )\n"
+   "      a *= smoothstep(c.z - aa * (c.w + 1.0), c.z - aa * c.w, d);\n"
+   "   if( a <= 0.0 )\n"
+   "      discard;\n"
+   "   gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * a);\n"
+   "}\n";
+
+static GLuint circleProgram = 0;
+static bool circleProgramTried = false;
+
+//compila o shader dos circulos na primeira chamada. Retorna false se nao ha shaders
+static bool circleProgramReady()
+{
+   if( circleProgram == 0 && !circleProgramTried )
+   {
+      circleProgramTried = true;
+      circleProgram = GLExt::BuildProgram(CIRCLE_VERTEX_SHADER, CIRCLE_FRAGMENT_SHADER);
+   }
+   return circleProgram != 0;
+}
+
+//desenha o circulo com o shader. Retorna false se o shader nao existe (usa os poligonos)
+static bool sdfCircle(float x, float y, float radius, float ringPixels)
+{
+   if( !circleProgramReady() )
+      return false;
+
+   GLExt::UseProgram(circleProgram);
+   glEnable(GL_BLEND);
+   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+   glBegin(GL_QUADS);
+      glTexCoord4f(-radius, -radius, radius, ringPixels); glVertex2d(x - radius, y - radius);
+      glTexCoord4f( radius, -radius, radius, ringPixels); glVertex2d(x + radius, y - radius);
+      glTexCoord4f( radius,  radius, radius, ringPixels); glVertex2d(x + radius, y + radius);
+      glTexCoord4f(-radius,  radius, radius, ringPixels); glVertex2d(x - radius, y + radius);
+   glEnd();
+   glDisable(GL_BLEND);
+   GLExt::UseProgram(0);
+   return true;
+}
+
+//numero de lados de um circulo depois de aplicar o nivel de detalhe
+static int circleDivisions(int div)
+{
+   int scaled = (int)(div * circleDetailScale);
+   return scaled < 6 ? 6 : scaled;
+}
+
 //conjunto de cores predefinidas. Pode-se adicionar mais cores.
 float Colors[14][3]=
 {
@@ -38,6 +128,7 @@ float Colors[14][3]=
 };
 
 void ConvertMouseCoord(int button, int state, int wheel, int direction, int x, int y);
+void reshape(int w, int h);
 
 //funcoes de CALLBACK da biblioteca Glut
 void keyboard(int key);
@@ -147,6 +238,10 @@ void CV::clear(float r, float g, float b)
 
 void CV::circle( float x, float y, float radius, int div )
 {
+   if( sdfCircle(x, y, radius, 1.0f) )
+      return;
+
+   div = circleDivisions(div);
    float ang = 0, x1, y1;
    float inc = PI_2/div;
    glBegin(GL_LINE_LOOP);
@@ -162,6 +257,10 @@ void CV::circle( float x, float y, float radius, int div )
 
 void CV::circleFill( float x, float y, float radius, int div )
 {
+   if( sdfCircle(x, y, radius, 0.0f) )
+      return;
+
+   div = circleDivisions(div);
    float ang = 0, x1, y1;
    float inc = PI_2/div;
    glBegin(GL_POLYGON);
@@ -203,6 +302,197 @@ void CV::translate(Vector2 offset)
    glTranslated(offset.x, offset.y, 0);
 }
 
+//offset seguido de escala. Tambem nao acumula.
+void CV::transform(float offsetX, float offsetY, float scale)
+{
+   glMatrixMode(GL_MODELVIEW);
+   glLoadIdentity();
+   glTranslated(offsetX, offsetY, 0);
+   glScaled(scale, scale, 1);
+}
+
+void CV::circleDetail(float detail)
+{
+   circleDetailScale = detail;
+}
+
+bool CV::sdfCircles()
+{
+   return circleProgramReady();
+}
+
+void CV::multisample(bool enabled)
+{
+   if( enabled )
+      glEnable(GL_MULTISAMPLE);
+   else
+      glDisable(GL_MULTISAMPLE);
+}
+
+//desenha numa area menor da tela, mantendo a mesma projecao
+void CV::beginScaledRender(float scale)
+{
+   activeRenderScale = scale < 0.25f ? 0.25f : (scale > 1.0f ? 1.0f : scale);
+   if( activeRenderScale >= 1.0f )
+      return;
+
+   glViewport(0, 0, (GLsizei)(*scrWidth * activeRenderScale), (GLsizei)(*scrHeight * activeRenderScale));
+}
+
+//copia a area reduzida para uma textura e desenha ela ampliada na tela inteira
+void CV::endScaledRender()
+{
+   if( activeRenderScale >= 1.0f )
+      return;
+
+   int w = (int)(*scrWidth * activeRenderScale);
+   int h = (int)(*scrHeight * activeRenderScale);
+
+   //texturas potencia de 2 para funcionar no OpenGL 1.1
+   if( scaledTexture == 0 || scaledTextureW < *scrWidth || scaledTextureH < *scrHeight )
+   {
+      if( scaledTexture == 0 )
+         glGenTextures(1, &scaledTexture);
+      scaledTextureW = 1;
+      scaledTextureH = 1;
+      while( scaledTextureW < *scrWidth ) scaledTextureW *= 2;
+      while( scaledTextureH < *scrHeight ) scaledTextureH *= 2;
+
+      glBindTexture(GL_TEXTURE_2D, scaledTexture);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+      glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, scaledTextureW, scaledTextureH, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+   }
+
+   glBindTexture(GL_TEXTURE_2D, scaledTexture);
+   glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, w, h);
+
+   glViewport(0, 0, *scrWidth, *scrHeight);
+   glMatrixMode(GL_MODELVIEW);
+   glLoadIdentity();
+
+   float s = (float)w / scaledTextureW;
+   float t = (float)h / scaledTextureH;
+   //linha 0 da textura e a parte de baixo da tela
+#if Y_CANVAS_CRESCE_PARA_CIMA == TRUE
+   float tY0 = 0, tYMax = t;
+#else
+   float tY0 = t, tYMax = 0;
+#endif
+
+   glEnable(GL_TEXTURE_2D);
+   glColor3f(1, 1, 1);
+   glBegin(GL_QUADS);
+      glTexCoord2f(0, tY0);   glVertex2d(0, 0);
+      glTexCoord2f(s, tY0);   glVertex2d(*scrWidth, 0);
+      glTexCoord2f(s, tYMax); glVertex2d(*scrWidth, *scrHeight);
+      glTexCoord2f(0, tYMax); glVertex2d(0, *scrHeight);
+   glEnd();
+   glDisable(GL_TEXTURE_2D);
+
+   activeRenderScale = 1.0f;
+}
+
+//restringe o desenho a uma parte da janela (tela dividida). As coordenadas passam a ir de 0 a w e de 0 a h
+//dentro dela. Com beginScaledRender ativo a area e reduzida junto com o resto do quadro
+void CV::viewport(int x, int y, int w, int h)
+{
+   glViewport((GLint)(x * activeRenderScale), (GLint)(y * activeRenderScale),
+              (GLsizei)(w * activeRenderScale), (GLsizei)(h * activeRenderScale));
+   glMatrixMode(GL_PROJECTION);
+   glLoadIdentity();
+#if Y_CANVAS_CRESCE_PARA_CIMA == TRUE
+   gluOrtho2D(0.0, w, 0.0, h);
+#else
+   gluOrtho2D(0.0, w, h, 0.0);
+#endif
+   glMatrixMode(GL_MODELVIEW);
+   glLoadIdentity();
+}
+
+//desenha numa area de w x h pixels no canto da janela, com coordenadas de 0 a w e 0 a h
+void CV::beginTextureRender(int w, int h)
+{
+   glViewport(0, 0, w, h);
+   glMatrixMode(GL_PROJECTION);
+   glLoadIdentity();
+#if Y_CANVAS_CRESCE_PARA_CIMA == TRUE
+   gluOrtho2D(0.0, w, 0.0, h);
+#else
+   gluOrtho2D(0.0, w, h, 0.0);
+#endif
+   glMatrixMode(GL_MODELVIEW);
+   glLoadIdentity();
+}
+
+//copia a area desenhada para a textura e volta a desenhar na tela inteira.
+//w e h devem ser potencia de 2 (OpenGL 1.1)
+void CV::endTextureRender(unsigned int &texture, int w, int h)
+{
+   if( texture == 0 )
+   {
+      glGenTextures(1, &texture);
+      glBindTexture(GL_TEXTURE_2D, texture);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+   }
+   glBindTexture(GL_TEXTURE_2D, texture);
+   glCopyTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 0, 0, w, h, 0);
+
+   reshape(*scrWidth, *scrHeight);
+}
+
+//desenha a textura inteira no retangulo (x1, y1) - (x2, y2)
+void CV::texturedRect(unsigned int texture, float x1, float y1, float x2, float y2)
+{
+   //linha 0 da textura e a parte de baixo da area copiada
+#if Y_CANVAS_CRESCE_PARA_CIMA == TRUE
+   float tY1 = 0, tY2 = 1;
+#else
+   float tY1 = 1, tY2 = 0;
+#endif
+
+   glBindTexture(GL_TEXTURE_2D, texture);
+   glEnable(GL_TEXTURE_2D);
+   glColor3f(1, 1, 1);
+   glBegin(GL_QUADS);
+      glTexCoord2f(0, tY1); glVertex2d(x1, y1);
+      glTexCoord2f(1, tY1); glVertex2d(x2, y1);
+      glTexCoord2f(1, tY2); glVertex2d(x2, y2);
+      glTexCoord2f(0, tY2); glVertex2d(x1, y2);
+   glEnd();
+   glDisable(GL_TEXTURE_2D);
+}
+
+void CV::multiplyBlend(bool enabled)
+{
+   if( enabled )
+   {
+      glEnable(GL_BLEND);
+      glBlendFunc(GL_DST_COLOR, GL_ZERO);
+   }
+   else
+   {
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+      glDisable(GL_BLEND);
+   }
+}
+
+void CV::continuousRedraw(bool enabled)
+{
+   continuousRedrawEnabled.store(enabled);
+}
+
+void CV::requestRedraw()
+{
+   redrawRequested.store(true);
+}
+
+bool CV::isRedrawingContinuously()
+{
+   return idleRedrawInstalled;
+}
+
 void CV::color(float r, float g, float b)
 {
    glColor3d(r, g, b);
@@ -233,6 +523,50 @@ void keyb(unsigned char key, int , int )
    keyboard(key);
 }
 
+//idle da glut: redesenha o mais rapido possivel (modo continuo com foco)
+static void idleRedraw(void)
+{
+   glutPostRedisplay();
+}
+
+//tick da politica de redesenho. instala/remove o idle e, fora do modo continuo,
+//so pede um quadro quando alguem chamou CV::requestRedraw().
+static void redrawTick(int )
+{
+   bool continuous = continuousRedrawEnabled.load();
+   bool runIdle = continuous && pointerInside && windowVisible;
+   if (runIdle != idleRedrawInstalled) {
+      glutIdleFunc(runIdle ? idleRedraw : NULL);
+      idleRedrawInstalled = runIdle;
+   }
+
+   int nextTickMs = REDRAW_POLL_MS;
+   if (!runIdle) {
+      bool requested = redrawRequested.exchange(false);
+      if (windowVisible && (requested || continuous)) {
+         glutPostRedisplay();
+      }
+      if (!pointerInside || !windowVisible) {
+         nextTickMs = INACTIVE_FRAME_MS;
+      }
+   }
+   glutTimerFunc(nextTickMs, redrawTick, 0);
+}
+
+//mouse entrou/saiu da janela. a glut nao tem callback de foco, entao o ponteiro faz esse papel
+static void entry(int state)
+{
+   pointerInside = (state == GLUT_ENTERED);
+   redrawRequested.store(true);
+}
+
+//janela minimizada ou totalmente coberta nao precisa ser redesenhada
+static void windowStatus(int state)
+{
+   windowVisible = (state != GLUT_HIDDEN && state != GLUT_FULLY_COVERED);
+   redrawRequested.store(true);
+}
+
 void keybUp(unsigned char key, int , int )
 {
    keyboardUp(key);
@@ -337,7 +671,9 @@ void CV::init(int *w, int *h, const char *title)
    glutSpecialUpFunc(specialUp);
    glutSpecialFunc(special);
 
-   glutIdleFunc(display);
+   glutTimerFunc(0, redrawTick, 0);
+   glutEntryFunc(entry);
+   glutWindowStatusFunc(windowStatus);
    glutMouseFunc(mouseClick);
    glutPassiveMotionFunc(motion);
    glutMotionFunc(motion);
@@ -37,7 +37,7 @@ public:
     static void polygon(float vx[], float vy[], int n_elems);
     static void polygonFill(float vx[], float vy[], int n_elems);
 
-    //centro e raio do circulo
+    //centro e raio do circulo. Com OpenGL 2.0 cada circulo e um quad suavizado por shader (div so vale sem shader)
     static void circle( float x, float y, float radius, int div );
     static void circle( Vector2 pos, float radius, int div );
 
@@ -61,6 +61,40 @@ public:
     static void translate(float x, float y);
     static void translate(Vector2 pos);
 
+    //offset seguido de escala uniforme (usado pela camera com zoom).
+    static void transform(float x, float y, float scale);
+
+    //controle de qualidade: fracao dos lados usados nos circulos (1 = div original)
+    static void circleDetail(float detail);
+
+    //true se os circulos sao desenhados pelo shader (quads com SDF). Nesse caso circleDetail nao tem efeito
+    static bool sdfCircles();
+
+    //liga/desliga o MSAA em tempo de execucao
+    static void multisample(bool enabled);
+
+    //desenha o mundo numa resolucao interna reduzida (scale < 1) e amplia para a tela em endScaledRender()
+    static void beginScaledRender(float scale);
+    static void endScaledRender();
+
+    //desenha so na area (x, y, w, h) da janela, com (x, y) no canto inferior esquerdo (tela dividida)
+    static void viewport(int x, int y, int w, int h);
+
+    //desenha numa textura de w x h (potencia de 2): tudo entre begin e end vai para a textura
+    static void beginTextureRender(int w, int h);
+    static void endTextureRender(unsigned int &texture, int w, int h);
+    static void texturedRect(unsigned int texture, float x1, float y1, float x2, float y2);
+
+    //mistura multiplicativa: a cor desenhada multiplica a cor da tela (branco nao altera nada)
+    static void multiplyBlend(bool enabled);
+
+    //politica de redesenho: continuo (a cada idle da glut) ou sob demanda.
+    //sob demanda so redesenha depois de requestRedraw(), que pode ser chamada de qualquer thread.
+    //com a janela sem foco (mouse fora) o redesenho continuo cai para poucos quadros por segundo.
+    static void continuousRedraw(bool enabled);
+    static void requestRedraw();
+    static bool isRedrawingContinuously(); //false quando sob demanda ou com a janela sem foco
+
     //funcao de inicializacao da Canvas2D. Recebe a largura, altura, e um titulo para a janela
     static void init(int *w, int *h, const char *title);
 
@@ -13,18 +13,44 @@
 #include <stdlib.h>
 #include <time.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
 #include "gl_canvas2d.h"
 
 #include "Tanque.h"
 #include "BSplineTrack.h"
 #include "Target.h"
-#include "Projectile.h"
+#include "ProjectileSystem.h"
 #include "PowerUp.h" 
+#include "GameClock.h"
+#include "GameSnapshot.h"
+#include "SnapshotBuffer.h"
+#include "SpscQueue.h"
+#include "QualityGovernor.h"
+#include "ExplosionManager.h"
+#include "Camera.h"
+#include "Minimap.h"
+#include "TrackShader.h"
+#include "FrameCapture.h"
+#include "DecalLayer.h"
+#include "Broadphase.h"
+#include "FlowField.h"
+#include "BulletPattern.h"
+#include "CommandBuffer.h"
+#include "TimerWheel.h"
 
 //largura e altura inicial da tela . Alteram com o redimensionamento de tela.
 int screenWidth = 1280, screenHeight = 720;
 
-Tanque *g_tanque = NULL;
+// jogadores locais: o primeiro usa A/D e o mouse, o segundo J/L para girar, K para atirar e I para o poder.
+// so os g_numPlayers primeiros estao no jogo ('2' liga/desliga a tela dividida)
+const int MAX_PLAYERS = 2;
+Tanque *g_tanks[MAX_PLAYERS] = {};
+int g_numPlayers = 1;
 BSplineTrack *g_track = NULL;
 
 bool g_editorMode = false;
@@ -32,21 +58,121 @@ bool g_mousePressed = false;
 
 int mouseX, mouseY; //variaveis globais do mouse para utilizar em qualquer lugar
 
-// flags para guardar rotacao do tanque
-bool keyA_down = false;
-bool keyD_down = false;
+// flags para guardar rotacao de cada tanque
+struct PlayerInput {
+    bool rotateLeft;
+    bool rotateRight;
+};
+PlayerInput g_playerInput[MAX_PLAYERS] = {};
 
 // numero de alvos por nivel
 const int NUM_TARGETS = 5;
+const int POINTS_PER_TARGET = 100;
 
 // variaveis globais para o jogo
-std::vector<Target> g_targets;
+TargetSet g_targets;
+ProjectileSystem g_projectiles; // tiros dos tanques e dos atiradores
+ExplosionManager g_explosions;  // particulas de todas as explosoes
+FlowField g_flowField;          // caminho pela pista ate os tanques, seguido pelas estrelas
+CommandBuffer g_commands;       // criacoes, destruicoes e troca de nivel pedidas durante o passo
 int g_playerScore = 0;
 int g_gameLevel = 1;  
 int g_destroyedTargets = 0; 
 PowerUp g_powerUp;
 PowerUpType g_storedPowerUp = PowerUpType::None;
 
+// grupos da fase ampla de colisao; um par so e gerado se a mascara de um inclui a camada do outro
+enum CollisionLayer {
+    LAYER_TANK = 1,
+    LAYER_TARGET = 2,
+    LAYER_PLAYER_BULLET = 4,
+    LAYER_ENEMY_BULLET = 8,
+    LAYER_POWERUP = 16
+};
+
+// tipos de contato, na ordem em que sao resolvidos
+enum class ContactKind {
+    BulletBullet,    // tiro do jogador intercepta um tiro inimigo
+    TankPowerUp,
+    TankStar,
+    TankEnemyBullet,
+    TankTarget,      // alvos basicos e atiradores
+    BulletTarget
+};
+const int NUM_CONTACT_KINDS = 6;
+
+struct Contact {
+    ContactKind kind;
+    int a; // jogador, ou o slot do tiro em BulletTarget e BulletBullet
+    int b; // id do alvo ou slot do tiro inimigo
+    Vector2 point; // ponto do encontro em BulletBullet
+};
+
+Broadphase g_broadphase;
+std::vector<BroadphasePair> g_pairs;
+std::vector<Contact> g_contacts;
+std::vector<unsigned char> g_bulletHits; // resultado do teste em lote de cada tanque contra os tiros
+
+// relogio da simulacao (passo fixo de 60 Hz)
+FixedTimestep g_clock(1.0f / 60.0f);
+
+// tipos de eventos de entrada repassados das callbacks da GLUT para a simulacao
+enum class InputEventType {
+    KeyDown,
+    KeyUp,
+    Mouse,
+    Resize
+};
+
+struct InputEvent {
+    InputEventType type;
+    int key;
+    int button, state, wheel, direction;
+    int x, y;
+};
+
+// comunicacao entre as threads: entrada vai por uma fila sem travas, o estado volta por snapshots
+SpscQueue<InputEvent, 1024> g_inputQueue;
+SnapshotBuffer<GameSnapshot> g_snapshots;
+std::atomic<bool> g_simulationRunning(false);
+std::thread g_simulationThread;
+
+// tamanho da tela como visto pela simulacao (atualizado por eventos de Resize)
+int g_simScreenWidth = 1280, g_simScreenHeight = 720;
+
+// cameras do jogo (segue o tanque) e do editor (movida pelo usuario)
+Camera g_gameCamera(1280, 720);
+Camera g_editorCamera(1280, 720);
+bool g_cameraPanning = false;   // arrasto da camera do editor com o botao direito
+int g_panLastX = 0, g_panLastY = 0;
+const float CAMERA_ZOOM_STEP = 1.1f;
+const float CAMERA_KEY_PAN = 40.0f; // pixels por toque nas setas
+
+// orcamento de tempo por quadro para o controle de qualidade (50 fps no minimo)
+const float FRAME_BUDGET_MS = 20.0f;
+QualityGovernor g_qualityGovernor(FRAME_BUDGET_MS);
+
+// minimapa com a pista em cache (usado so pela thread de renderizacao)
+Minimap g_minimap;
+
+// pista avaliada na GPU quando ha shaders (usado so pela thread de renderizacao)
+TrackShader g_trackShader;
+
+// marcas de tiros e esteiras acumuladas em texturas do mundo (usado so pela thread de renderizacao)
+DecalLayer g_decals;
+
+// ultima posicao onde cada tanque deixou marca de esteira (thread de simulacao)
+Vector2 g_lastTreadPosition[MAX_PLAYERS];
+const float TREAD_SPACING = 6.0f;       // distancia percorrida entre duas marcas
+const float TREAD_MAX_JUMP = 50.0f;     // acima disso o tanque foi reposicionado, nao deixa rastro
+
+// captura de tela ('C') e de video ('V'), controlada pela thread de renderizacao
+FrameCapture g_capture;
+
+// ultima copia da pista publicada, compartilhada entre snapshots ate a proxima edicao
+std::shared_ptr<const BSplineTrack> g_publishedTrack;
+unsigned int g_publishedTrackRevision = 0;
+
 // gera uma posicao aleatoria no track, usada para gerar alvos e power ups
 Vector2 GenerateRandomPosTrack(BSplineTrack* track, const Vector2& avoidPosition = Vector2(0,0), bool checkAvoidance = false) {
     const int MAX_ATTEMPTS = 1000; // maximo de tentativas para achar posicao
@@ -80,13 +206,17 @@ Vector2 GenerateRandomPosTrack(BSplineTrack* track, const Vector2& avoidPosition
 
         // checa distancia de outros alvos
         bool tooCloseToOtherTargets = false;
-        for (const auto& target : g_targets) {
-            if (target.active) {
-                float distSq = position.distSq(target.position);
-                if (distSq < 50.0f * 50.0f) { 
-                    tooCloseToOtherTargets = true;
-                    break;
-                }
+        g_targets.ForEach([&](int, const TargetBody& target) {
+            if (target.active && position.distSq(target.position) < 50.0f * 50.0f) {
+                tooCloseToOtherTargets = true;
+            }
+        });
+
+        // e dos alvos que ja foram pedidos mas ainda nao foram criados
+        for (int i = 0; i < g_commands.Count() && !tooCloseToOtherTargets; i++) {
+            const GameCommand& command = g_commands.Get(i);
+            if (command.type == CommandType::SpawnTarget && position.distSq(command.position) < 50.0f * 50.0f) {
+                tooCloseToOtherTargets = true;
             }
         }
 
@@ -100,8 +230,8 @@ Vector2 GenerateRandomPosTrack(BSplineTrack* track, const Vector2& avoidPosition
     return Vector2(0, 0);
 }
 
-// spawna o tanque no inicio do track
-void resetTankToTrackStart(Tanque* tanque, BSplineTrack* track) {
+// spawna o tanque no inicio do track (lateral: 0 = borda esquerda, 1 = direita)
+void resetTankToTrackStart(Tanque* tanque, BSplineTrack* track, float lateral = 0.5f) {
     if (!tanque || !track) {
         return;
     }
@@ -113,7 +243,7 @@ void resetTankToTrackStart(Tanque* tanque, BSplineTrack* track) {
     start_point_left = track->getPointOnCurve(0.0f, CurveSide::Left);
     start_point_right = track->getPointOnCurve(0.0f, CurveSide::Right);
 
-    tanque->position.set((start_point_left.x + start_point_right.x) / 2.0f,(start_point_left.y + start_point_right.y) / 2.0f);
+    tanque->position = start_point_left.lerp(start_point_right, lateral);
 
 
     // calcula a tangente do tanque no track (direcao que ele spawna)
@@ -136,6 +266,7 @@ void resetTankToTrackStart(Tanque* tanque, BSplineTrack* track) {
 
 
     tanque->forwardVector.set(cos(tanque->baseAngle), sin(tanque->baseAngle));
+    tanque->ResetInterpolation();
 }
 
 // spawna um power-up no track
@@ -144,7 +275,7 @@ void SpawnPowerUp(BSplineTrack* track) {
     if (g_powerUp.active || g_storedPowerUp != PowerUpType::None) return;
 
     // gera uma posicao aleatoria no track
-    Vector2 position = GenerateRandomPosTrack(track, g_tanque->position, true);
+    Vector2 position = GenerateRandomPosTrack(track, g_tanks[0]->position, true);
 
     // escolhe um tipo de power-up aleatorio
     int randType = rand() % 3 + 1; // 1-3
@@ -154,15 +285,54 @@ void SpawnPowerUp(BSplineTrack* track) {
     g_powerUp = PowerUp(position, type);
 }
 
-// inicializa os alvos do jogo
+// ajusta um alvo recem-criado ao nivel atual
+void ConfigureTarget(int id) {
+    TargetType targetType = TargetSet::IdType(id);
+    TargetBody& target = g_targets.Body(id);
+
+    // vida aumenta com o nivel
+    target.maxHealth = 2 + (g_gameLevel - 1);
+
+    // shooter tem +1 de vida
+    if (targetType == TargetType::Shooter) {
+        target.maxHealth += 1;
+        ShooterState& shooter = g_targets.shooters[TargetSet::IdIndex(id)];
+
+        // cada nivel libera mais um padrao de tiro da tabela (o nivel 2 so tem o tiro simples)
+        int unlocked = std::min(g_gameLevel - 1, GetBulletPatternCount());
+        shooter.pattern = rand() % std::max(1, unlocked);
+        shooter.firingCooldownReset = GetBulletPattern(shooter.pattern).cooldown;
+    }
+    // estrela tem +2 de vida
+    else if (targetType == TargetType::Star) {
+        target.maxHealth += 2;
+        StarState& star = g_targets.stars[TargetSet::IdIndex(id)];
+
+        // estrela move mais rapido com o nivel
+        star.moveSpeed = 0.5f + (g_gameLevel * 0.1f);
+
+        // estrelas detectam de mais longe em niveis mais altos
+        star.detectionRadius = 150.0f + (g_gameLevel * 25.0f);
+
+        // a velocidade de rotação aumenta ligeiramente com o nível
+        star.rotationSpeed = 0.05f + (g_gameLevel - 1) * 0.01f;
+    }
+
+    target.health = target.maxHealth;
+}
+
+// inicializa os alvos do jogo. os alvos em si sao criados quando os comandos forem aplicados;
+// comandos ainda pendentes se referem aos alvos antigos e sao descartados
 void InitializeTargets(BSplineTrack* track) {
-    g_targets.clear();
+    g_targets.Clear();
+    g_commands.Clear();
+    g_projectiles.Clear(ProjectileTeam::Enemy);
     g_destroyedTargets = 0; 
 
     // cria os alvos
     for (int i = 0; i < NUM_TARGETS; i++) {
         // encontra uma boa posição para o alvo
-        Vector2 position = GenerateRandomPosTrack(track, g_tanque->position, true);
+        Vector2 position = GenerateRandomPosTrack(track, g_tanks[0]->position, true);
 
         
         TargetType targetType = TargetType::Basic; 
@@ -184,52 +354,74 @@ void InitializeTargets(BSplineTrack* track) {
             targetType = TargetType::Shooter;
         }
 
-        // cria o alvo de fato
-        Target target(position, targetType);
-        target.active = true;
+        g_commands.SpawnTarget(position, targetType);
+    }
 
-        // vida aumenta com o nivel
-        target.maxHealth = 2 + (g_gameLevel - 1);
+    SpawnPowerUp(track);
+}
 
-        // shooter tem +1 de vida
-        if (target.type == TargetType::Shooter) {
-            target.maxHealth += 1;
-        }
-        // estrela tem +2 de vida
-        else if (target.type == TargetType::Star) {
-            target.maxHealth += 2;
+// executa os comandos do passo numa passada so: e o unico lugar que conta pontos e passa de nivel.
+// passar de nivel recria os alvos como novos comandos, que sao executados na mesma passada
+void ApplyCommands() {
+    int i = 0;
+    while (i < g_commands.Count()) {
+        // copia: executar um comando pode registrar outros
+        GameCommand command = g_commands.Get(i++);
+
+        switch (command.type) {
+        case CommandType::SpawnTarget:
+            ConfigureTarget(g_targets.Add(command.position, command.targetType));
+            break;
 
-            // estrela move mais rapido com o nivel
-            target.moveSpeed = 0.5f + (g_gameLevel * 0.1f);
+        case CommandType::DestroyTarget:
+            if (!g_targets.IsValid(command.id)) break;
+            g_targets.Body(command.id).active = false;
+            g_playerScore += POINTS_PER_TARGET;
 
-            // estrelas detectam de mais longe em niveis mais altos
-            target.detectionRadius = 150.0f + (g_gameLevel * 25.0f);
+            // checa se todos morreram e passa o level
+            if (++g_destroyedTargets == NUM_TARGETS) {
+                g_commands.LevelUp();
+            }
+            break;
 
-            // a velocidade de rotação aumenta ligeiramente com o nível
-            target.rotationSpeed = 0.05f + (g_gameLevel - 1) * 0.01f;
+        case CommandType::LevelUp:
+            g_gameLevel++;
+            // limpa o buffer e registra os alvos novos; a passada recomeca por eles
+            InitializeTargets(g_track);
+            i = 0;
+            break;
         }
+    }
+    g_commands.Clear();
 
-        target.health = target.maxHealth;
+    // os destruidos saem dos arrays; os ids mudam aqui, e os tiros dos atiradores acompanham
+    g_targets.RemoveInactive(g_projectiles);
+}
 
-        g_targets.push_back(target);
+// coloca os tanques ativos lado a lado no inicio do track
+void ResetPlayersToTrackStart(BSplineTrack* track) {
+    for (int p = 0; p < g_numPlayers; p++) {
+        resetTankToTrackStart(g_tanks[p], track, static_cast<float>(p + 1) / (g_numPlayers + 1));
     }
-
-    SpawnPowerUp(track);
 }
 
 // reseta tudo
-void ResetGameState(Tanque* tanque, BSplineTrack* track) {
+void ResetGameState(BSplineTrack* track) {
     g_playerScore = 0;
     g_gameLevel = 1;  
     g_destroyedTargets = 0;  
 
-    if (tanque) {
+    // novo jogo comeca com o chao limpo
+    DecalLayer::Stamp(DecalKind::Clear, Vector2(0, 0), 0.0f, 0.0f);
+
+    for (int p = 0; p < g_numPlayers; p++) {
+        Tanque* tanque = g_tanks[p];
         tanque->health = tanque->maxHealth;
-        tanque->isInvulnerable = false;
-        tanque->invulnerabilityTimer = 0;
+        tanque->ClearInvulnerability();
     }
 
     InitializeTargets(track);
+    ApplyCommands();
 
     g_powerUp.active = false;
     g_storedPowerUp = PowerUpType::None;
@@ -238,7 +430,7 @@ void ResetGameState(Tanque* tanque, BSplineTrack* track) {
 }
 
 // uso do power up
-void UsePowerUp(Tanque* tank, std::vector<Target>& targets) {
+void UsePowerUp(Tanque* tank, TargetSet& targets) {
     if (!tank || g_storedPowerUp == PowerUpType::None) return;
 
     switch (g_storedPowerUp) {
@@ -250,21 +442,10 @@ void UsePowerUp(Tanque* tank, std::vector<Target>& targets) {
             PowerUp::ApplyShieldEffect(tank);
             break;
 
-        case PowerUpType::Laser: {
-            int targetsDestroyed = PowerUp::ApplyLaserEffect(tank, targets);
-
-            
-            g_playerScore += targetsDestroyed * 100;
-            g_destroyedTargets += targetsDestroyed;
-
-            
-            if (g_destroyedTargets >= NUM_TARGETS) {
-                
-                g_gameLevel++;
-                InitializeTargets(g_track);
-            }
+        case PowerUpType::Laser:
+            // pontos e troca de nivel ficam para o fim do passo
+            PowerUp::ApplyLaserEffect(tank, targets, g_explosions, g_track, g_commands);
             break;
-        }
 
         default:
             break;
@@ -274,280 +455,564 @@ void UsePowerUp(Tanque* tank, std::vector<Target>& targets) {
     g_storedPowerUp = PowerUpType::None;
 }
 
-//funcao chamada continuamente. Deve-se controlar o que desenhar por meio de variaveis globais
-//Todos os comandos para desenho na canvas devem ser chamados dentro da render().
-//Deve-se manter essa funo com poucas linhas de codigo
-void render()
+// area da janela de cada jogador: a tela e dividida em colunas iguais
+void GetPlayerViewport(int player, int numPlayers, int width, int height, int& x, int& y, int& w, int& h)
 {
-    CV::clear(0.25f, 0.25f, 0.3f);
+    w = width / numPlayers;
+    h = height;
+    x = player * w;
+    y = 0;
+}
+
+// mira de cada jogador: o primeiro mira com o mouse na sua parte da tela, o segundo mira para frente
+Vector2 GetPlayerAim(int player)
+{
+    Tanque* tank = g_tanks[player];
+    if (player > 0) {
+        return tank->position + tank->forwardVector * 100.0f;
+    }
+
+    int vx, vy, vw, vh;
+    GetPlayerViewport(player, g_numPlayers, g_simScreenWidth, g_simScreenHeight, vx, vy, vw, vh);
+    Camera view = g_gameCamera;
+    view.SetViewport(static_cast<float>(vw), static_cast<float>(vh));
+    view.center = tank->position;
+    return view.ScreenToWorld(static_cast<float>(mouseX - vx), static_cast<float>(mouseY - vy));
+}
 
+// coloca tanques, alvos, projeteis e o power-up na fase ampla e confirma cada par
+// com o teste exato do par. o resultado e a lista de contatos do passo
+void BuildContacts()
+{
+    g_broadphase.Clear();
+
+    for (int p = 0; p < g_numPlayers; p++) {
+        Tanque* tank = g_tanks[p];
+        // meia diagonal da base envolve o tanque em qualquer angulo
+        float radius = 0.5f * sqrtf(tank->baseWidth * tank->baseWidth + tank->baseHeight * tank->baseHeight);
+        g_broadphase.Add(tank->position.x, tank->position.y, radius,
+                         LAYER_TANK, LAYER_TARGET | LAYER_POWERUP, p);
+    }
 
-    // pra seguir o tanque a tela
-    if(!g_editorMode){
-        CV::translate(-g_tanque->position.x + screenWidth/2, -g_tanque->position.y + screenHeight/2);
+    g_targets.ForEach([](int id, const TargetBody& body) {
+        if (body.active) {
+            g_broadphase.Add(body.position.x, body.position.y, g_targets.ShapeRadius(id), LAYER_TARGET, 0, id);
+        }
+    });
+
+    // cada tiro entra com o circulo que envolve o movimento do passo inteiro, para o teste
+    // continuo entre tiros. os inimigos sao passivos (mascara 0): sao milhares e nao procuram
+    // vizinhos, so sao achados pelos tiros dos jogadores. contra os tanques eles sao testados
+    // direto nos arrays do sistema de projeteis
+    for (int i = 0; i < g_projectiles.GetUsedSlots(); i++) {
+        if (!g_projectiles.active[i]) continue;
+        float midX = 0.5f * (g_projectiles.prevX[i] + g_projectiles.posX[i]);
+        float midY = 0.5f * (g_projectiles.prevY[i] + g_projectiles.posY[i]);
+        float halfX = 0.5f * (g_projectiles.posX[i] - g_projectiles.prevX[i]);
+        float halfY = 0.5f * (g_projectiles.posY[i] - g_projectiles.prevY[i]);
+        float radius = g_projectiles.radius[i] + sqrtf(halfX * halfX + halfY * halfY);
+        if (g_projectiles.team[i] == ProjectileTeam::Player) {
+            g_broadphase.Add(midX, midY, radius, LAYER_PLAYER_BULLET, LAYER_TARGET | LAYER_ENEMY_BULLET, i);
+        } else {
+            g_broadphase.Add(midX, midY, radius, LAYER_ENEMY_BULLET, 0, i);
+        }
     }
 
-    // renderiza o track
-    if (g_track) {
-        g_track->Render(g_editorMode);
+    if (g_powerUp.active) {
+        g_broadphase.Add(g_powerUp.position.x, g_powerUp.position.y, g_powerUp.radius, LAYER_POWERUP, 0, 0);
     }
 
-   // renderiza power ups
-    if (!g_editorMode) {
-        g_powerUp.Update();
-        g_powerUp.Render();
+    g_broadphase.FindPairs(g_pairs);
 
+    g_contacts.clear();
 
-        PowerUp::UpdateLaserEffect();
-    }
+    for (size_t i = 0; i < g_pairs.size(); i++) {
+        const BroadphaseProxy* a = &g_broadphase.GetProxy(g_pairs[i].a);
+        const BroadphaseProxy* b = &g_broadphase.GetProxy(g_pairs[i].b);
+        // deixa a camada de bit menor em a: tanque < alvo < tiro do jogador < tiro inimigo < power-up
+        if (a->layer > b->layer) std::swap(a, b);
+
+        Contact contact;
+        if (a->layer == LAYER_TANK) {
+            Tanque* tank = g_tanks[a->user];
+            contact.a = a->user;
+            contact.b = b->user;
 
-   // renderiza os inimigos
-    if (!g_editorMode) {
-        for (auto& target : g_targets) {
-            target.Render();
+            if (b->layer == LAYER_TARGET) {
+                if (!g_targets.Overlaps(b->user, tank->GetBodyShape())) continue;
+                contact.kind = TargetSet::IdType(b->user) == TargetType::Star ? ContactKind::TankStar : ContactKind::TankTarget;
+            } else {
+                if (!g_powerUp.CheckCollection(tank->position, tank->baseWidth/2.0f)) continue;
+                contact.kind = ContactKind::TankPowerUp;
+            }
+        } else if (a->layer == LAYER_TARGET) {
+            // alvo contra tiro do jogador, na posicao do fim do passo
+            int slot = b->user;
+            CircleShape bullet(g_projectiles.GetPosition(slot), g_projectiles.radius[slot]);
+            if (!g_targets.Overlaps(a->user, bullet)) continue;
+            contact.kind = ContactKind::BulletTarget;
+            contact.a = slot;
+            contact.b = a->user;
+        } else {
+            // tiro do jogador contra tiro inimigo: teste continuo, tiros rapidos nao se atravessam
+            int player = a->user, enemy = b->user;
+            Vector2 playerFrom(g_projectiles.prevX[player], g_projectiles.prevY[player]);
+            Vector2 enemyFrom(g_projectiles.prevX[enemy], g_projectiles.prevY[enemy]);
+            Vector2 playerDelta(g_projectiles.posX[player] - playerFrom.x, g_projectiles.posY[player] - playerFrom.y);
+            Vector2 enemyDelta(g_projectiles.posX[enemy] - enemyFrom.x, g_projectiles.posY[enemy] - enemyFrom.y);
+            float time;
+            if (!SweepCircles(playerFrom, playerDelta, g_projectiles.radius[player],
+                              enemyFrom, enemyDelta, g_projectiles.radius[enemy], time)) continue;
+
+            // o encontro fica entre os dois centros no instante do toque
+            contact.kind = ContactKind::BulletBullet;
+            contact.a = player;
+            contact.b = enemy;
+            contact.point.set(0.5f * (playerFrom.x + playerDelta.x * time + enemyFrom.x + enemyDelta.x * time),
+                              0.5f * (playerFrom.y + playerDelta.y * time + enemyFrom.y + enemyDelta.y * time));
         }
+        g_contacts.push_back(contact);
     }
 
-    // renderiza o efeito do laser (deve ser renderizado após os inimigos, mas antes do tanque)
-    if (!g_editorMode) {
-        PowerUp::RenderLaserEffect();
+    // caixa de cada tanque contra todos os slots de tiro de uma vez (SSE); os inativos
+    // e os tiros dos jogadores sao descartados depois
+    int usedSlots = g_projectiles.GetUsedSlots();
+    g_bulletHits.resize(usedSlots);
+    for (int p = 0; p < g_numPlayers && usedSlots > 0; p++) {
+        if (OverlapCircles(g_tanks[p]->GetBodyShape(), g_projectiles.posX, g_projectiles.posY,
+                           g_projectiles.radius, usedSlots, g_bulletHits.data()) == 0) continue;
+        for (int i = 0; i < usedSlots; i++) {
+            if (!g_bulletHits[i] || !g_projectiles.active[i] || g_projectiles.team[i] != ProjectileTeam::Enemy) continue;
+            Contact contact;
+            contact.kind = ContactKind::TankEnemyBullet;
+            contact.a = p;
+            contact.b = i;
+            g_contacts.push_back(contact);
+        }
     }
 
-    // renderiza o tanque fora do editor
-    if (!g_editorMode && g_tanque) {
-        g_tanque->Update(static_cast<float>(mouseX + g_tanque->position.x - screenWidth/2),
-                        static_cast<float>(mouseY + g_tanque->position.y - screenHeight/2),
-                        keyA_down, keyD_down, g_track);
+    // a ordem dos pares depende da tabela hash; ordenar deixa a resolucao deterministica
+    std::sort(g_contacts.begin(), g_contacts.end(), [](const Contact& x, const Contact& y) {
+        if (x.kind != y.kind) return x.kind < y.kind;
+        if (x.a != y.a) return x.a < y.a;
+        return x.b < y.b;
+    });
+}
 
-        // att os targets
-        for (auto& target : g_targets) {
-            target.Update(g_tanque->position, g_track);
-        }
+// aplica um contato. blocked[p] diz se o tanque p ignora golpes nesta fase.
+// alvos destruidos so sao contados no fim do passo, entao os ids continuam validos aqui
+void ResolveContact(const Contact& contact, bool* blocked)
+{
+    switch (contact.kind) {
+    case ContactKind::BulletBullet:
+        // os dois tiros se anulam com uma explosao pequena no ponto do encontro
+        if (!g_projectiles.active[contact.a] || !g_projectiles.active[contact.b]) break;
+        g_explosions.CreateExplosion(contact.point, g_projectiles.GetVelocity(contact.a), 8);
+        g_projectiles.Remove(contact.a);
+        g_projectiles.Remove(contact.b);
+        break;
 
-        // checa se ele pegou o power-up
-        if (g_powerUp.active && g_powerUp.CheckCollection(g_tanque->position, g_tanque->baseWidth/2.0f)) {
-            // armazena o tipo de power-up e desativa ele do chao
+    case ContactKind::TankPowerUp:
+        // o primeiro tanque a encostar leva o power-up
+        if (g_powerUp.active) {
             g_storedPowerUp = g_powerUp.type;
             g_powerUp.active = false;
-
         }
+        break;
 
-        // checa dano
-        if (!g_tanque->isInvulnerable) {
-            // a estrela deve dar muito dano, checa colisao com ela
-            for (size_t i = 0; i < g_targets.size(); i++) {
-                Target& target = g_targets[i];
-                if (target.active && target.type == TargetType::Star) {
-                    float dx = target.position.x - g_tanque->position.x;
-                    float dy = target.position.y - g_tanque->position.y;
-                    float distSq = dx*dx + dy*dy;
-                    float combinedRadius = g_tanque->baseWidth/2.0f + target.radius;
-
-                    if (distSq < combinedRadius * combinedRadius) {
-                        // checa escudo
-                        if (g_tanque->hasShield) {
-                            g_tanque->hasShield = false; 
-                            g_tanque->isInvulnerable = true;
-                            g_tanque->isShieldInvulnerable = true; 
-                            g_tanque->invulnerabilityTimer = g_tanque->INVULNERABILITY_FRAMES;
-                            
-
-                            // a estrela sempre morre ao bater no tanque
-                            target.active = false;
-                        } else {
-                            // aplica o dano normal da estrela
-                            int damage = g_tanque->maxHealth / 2;
-                            g_tanque->health -= damage;
-                            if (g_tanque->health < 0) g_tanque->health = 0;
-
-                           
-                            g_tanque->isInvulnerable = true;
-                            g_tanque->isShieldInvulnerable = false; 
-                            g_tanque->invulnerabilityTimer = g_tanque->INVULNERABILITY_FRAMES;
-
-                            // a estrela sempre morre ao bater no tanque
-                            target.active = false;
-                        }
-
-                        // a estrela morre, entao ganha pontos e aumenta o contador
-                        g_playerScore += 100;  
-                        g_destroyedTargets++;
-
-                        // checa se todos morreram e passa o level
-                        if (g_destroyedTargets >= NUM_TARGETS) {
-                            g_gameLevel++;
-                            InitializeTargets(g_track);
-                        }
-                    }
-                }
-            }
+    case ContactKind::TankStar: {
+        if (blocked[contact.a]) break;
+        TargetBody& star = g_targets.Body(contact.b);
+        if (!star.active) break;
+
+        // a estrela da muito dano e sempre morre ao bater no tanque
+        g_tanks[contact.a]->ApplyHit(g_tanks[contact.a]->maxHealth / 2);
+        star.active = false;
+        g_commands.DestroyTarget(contact.b);
+        break;
+    }
+
+    case ContactKind::TankEnemyBullet:
+        if (blocked[contact.a] || !g_projectiles.active[contact.b]) break;
+        g_projectiles.Remove(contact.b);
+        g_tanks[contact.a]->ApplyHit(g_tanks[contact.a]->maxHealth / 8);
+        break;
+
+    case ContactKind::TankTarget: {
+        if (blocked[contact.a]) break;
+        TargetBody& target = g_targets.Body(contact.b);
+        if (!target.active) break;
+
+        // agora o tanque esta invulneravel, entao so a primeira batida conta
+        blocked[contact.a] = true;
+        if (g_tanks[contact.a]->CollideWithTarget(target)) {
+            g_commands.DestroyTarget(contact.b);
         }
+        break;
+    }
 
-        // checa projeteis no tanque
-        if (!g_tanque->isInvulnerable) {
-            for (auto& target : g_targets) {
-                if (target.active && target.type == TargetType::Shooter) {
-                    for (auto& proj : target.projectiles) { // passa por todos os projeteis dos shooters
-                        if (proj.active) {
-                            // checa se o projeteis colide com o tanque
-                            float dx = proj.position.x - g_tanque->position.x;
-                            float dy = proj.position.y - g_tanque->position.y;
-                            float distSq = dx*dx + dy*dy;
-                            float combinedRadius = g_tanque->baseWidth/2.0f + proj.radius;  
-
-                            if (distSq < combinedRadius * combinedRadius) {
-                               
-                                proj.active = false;    
-
-                                // checa escudo
-                                if (g_tanque->hasShield) {
-                                    
-                                    g_tanque->hasShield = false; 
-                                   
-                                    g_tanque->isInvulnerable = true;
-                                    g_tanque->isShieldInvulnerable = true; 
-                                    g_tanque->invulnerabilityTimer = g_tanque->INVULNERABILITY_FRAMES;                               
-                                } else {
-                                    // sem escudo, aplica dano
-                                    int damage = g_tanque->maxHealth / 8; 
-                                    g_tanque->health -= damage;
-                                    if (g_tanque->health < 0) g_tanque->health = 0;
-
-                                   
-                                    g_tanque->isInvulnerable = true;
-                                    g_tanque->isShieldInvulnerable = false; 
-                                    g_tanque->invulnerabilityTimer = g_tanque->INVULNERABILITY_FRAMES;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+    case ContactKind::BulletTarget: {
+        if (!g_projectiles.active[contact.a]) break;
+        TargetBody& target = g_targets.Body(contact.b);
+        if (!target.active) break;
+
+        // explosao do tiro e outra na posicao do alvo
+        g_projectiles.Explode(contact.a, &g_explosions);
+        g_explosions.CreateExplosion(target.position, g_projectiles.GetVelocity(contact.a), 25);
+        g_projectiles.Remove(contact.a);
+
+        target.TakeDamage(1);
+        if (!target.active) {
+            g_commands.DestroyTarget(contact.b);
         }
+        break;
+    }
+    }
+}
 
-        // checa colisao do tanque com os alvos normais
-        int destroyedTargetIndex = g_tanque->CheckTargetCollisions(g_targets);
-        if (destroyedTargetIndex >= 0) {
-            // alvo e destruido com colisao
-            g_playerScore += 100;
-            g_destroyedTargets++;   
+// resolve os contatos do passo por fases, na ordem de ContactKind.
+// um passo pode ter varios acertos: cada tiro e cada alvo sao conferidos de novo antes de aplicar
+void ResolveContacts()
+{
+    bool blocked[MAX_PLAYERS] = {};
+    size_t i = 0;
 
-            // checa se todos morreram e passa o level
-            if (g_destroyedTargets >= NUM_TARGETS) {
-               
-                g_gameLevel++;
-                InitializeTargets(g_track); 
-            }
+    for (int k = 0; k < NUM_CONTACT_KINDS; k++) {
+        ContactKind kind = static_cast<ContactKind>(k);
+
+        // estado dos tanques no inicio da fase
+        for (int p = 0; p < g_numPlayers; p++) {
+            blocked[p] = g_tanks[p]->isInvulnerable;
         }
 
-        // checa projeteis do tanque contra os alvos
-        int hitTargetIndex = -1;
-        int hitProjectileIndex = -1;
-        if (g_tanque->CheckAllProjectilesAgainstTargets(g_targets, hitTargetIndex, hitProjectileIndex)) {
-            // aplica o dano ao alvo
-            if (hitTargetIndex >= 0 && hitTargetIndex < static_cast<int>(g_targets.size())) {
-                // pega a posicao do alvo e a o vetor do projetil pra explosao
-                Vector2 hitPosition = g_targets[hitTargetIndex].position;
-                Vector2 hitVelocity = Vector2(0, 0);
-
-                if (hitProjectileIndex >= 0 && hitProjectileIndex < static_cast<int>(g_tanque->projectiles.size())) {
-                    hitVelocity = g_tanque->projectiles[hitProjectileIndex].velocity;
-                    // cria a explosao na posicao do alvo
-                    g_tanque->explosions.CreateExplosion(hitPosition, hitVelocity, 25);
-                }
+        for (; i < g_contacts.size() && g_contacts[i].kind == kind; i++) {
+            ResolveContact(g_contacts[i], blocked);
+        }
+    }
+}
+
+// deixa as marcas das esteiras a cada TREAD_SPACING percorrido
+void StampTreads(int player)
+{
+    Tanque* tank = g_tanks[player];
+    float moved = (tank->position - g_lastTreadPosition[player]).length();
+    if (moved > TREAD_MAX_JUMP) {
+        g_lastTreadPosition[player] = tank->position;
+    } else if (moved >= TREAD_SPACING) {
+        DecalLayer::Stamp(DecalKind::Tread, tank->position, tank->baseAngle, tank->baseHeight * 0.8f);
+        g_lastTreadPosition[player] = tank->position;
+    }
+}
 
-                // aplica dano ao alvo
-                g_targets[hitTargetIndex].TakeDamage(1);    
+// avanca a simulacao do jogo em um passo fixo (todas as constantes de movimento sao por passo)
+void UpdateGame()
+{
+    if (!g_tanks[0]) return;
 
-                // se o alvo morreu, da ponto e aumenta o contador
-                if (!g_targets[hitTargetIndex].active) {
-                    g_playerScore += 100;
-                    g_destroyedTargets++;
+    // timers que vencem neste passo (recargas, invulnerabilidade, tempo de vida dos tiros, laser)
+    SimulationTimers().Advance();
 
-                    // checa se todos morreram e passa o level
-                    if (g_destroyedTargets >= NUM_TARGETS) {
-                       
-                        g_gameLevel++;
-                        InitializeTargets(g_track);  
-                    }
-                }
-            }
+    // att o power up
+    g_powerUp.Update();
 
-            if (hitProjectileIndex >= 0 && hitProjectileIndex < static_cast<int>(g_tanque->projectiles.size())) {
-                g_tanque->projectiles[hitProjectileIndex].active = false;
-            }
+    // att os tanques
+    for (int p = 0; p < g_numPlayers; p++) {
+        Vector2 aim = GetPlayerAim(p);
+        g_tanks[p]->Update(aim.x, aim.y, g_playerInput[p].rotateLeft, g_playerInput[p].rotateRight, g_track);
+        StampTreads(p);
+    }
+
+    // att os targets
+    Vector2 tankPositions[MAX_PLAYERS];
+    for (int p = 0; p < g_numPlayers; p++) tankPositions[p] = g_tanks[p]->position;
+    // o campo so e usado pelas estrelas; quando um tanque troca de celula ele e refeito numa thread propria
+    if (g_track && !g_targets.bodies[static_cast<int>(TargetType::Star)].empty()) {
+        g_flowField.Update(*g_track, tankPositions, g_numPlayers);
+    }
+    g_targets.Update(tankPositions, g_numPlayers, g_projectiles, g_track, &g_flowField);
+
+    // att todos os projeteis e as particulas
+    g_projectiles.Update(g_track, &g_explosions);
+    g_explosions.Update();
+
+    // todas as colisoes do passo numa passada so
+    BuildContacts();
+    ResolveContacts();
+
+    // mudancas estruturais pedidas no passo (inclusive pelo laser, na entrada)
+    ApplyCommands();
+}
+
+// no editor, coloca o tanque so na posicao inicial que ele spawnaria
+void UpdateEditorPreview()
+{
+    Tanque* tank = g_tanks[0];
+    if (!tank || !g_track) return;
+
+    Vector2 pL = g_track->getPointOnCurve(0.0f, CurveSide::Left);
+    Vector2 pR = g_track->getPointOnCurve(0.0f, CurveSide::Right);
+    tank->position = (pL + pR) * 0.5f;  
+
+    Vector2 tangentL = g_track->getTangentOnCurve(0.0f, CurveSide::Left);
+    Vector2 tangentR = g_track->getTangentOnCurve(0.0f, CurveSide::Right);
+    Vector2 avgTangent = (tangentL + tangentR) * 0.5f;
+
+    if (avgTangent.lengthSq() > 0.001f) { 
+        avgTangent.normalize();
+        tank->baseAngle = atan2(avgTangent.y, avgTangent.x);
+    } else {
+        tank->baseAngle = 0.0f; 
+    }
+    tank->topAngle = tank->baseAngle; 
+    tank->forwardVector.set(cos(tank->baseAngle), sin(tank->baseAngle));
+    tank->ResetInterpolation();
+}
+
+// copia o estado da simulacao para o buffer de tras e publica para a renderizacao
+void PublishSnapshot()
+{
+    GameSnapshot& snapshot = g_snapshots.BeginWrite();
+
+    // as contagens ficam na roda de timers; o desenho le o que falta em cada uma
+    for (int p = 0; p < g_numPlayers; p++) g_tanks[p]->RefreshCountdowns();
+    g_targets.RefreshCountdowns();
+    PowerUp::RefreshLaserCountdown();
+
+    // reaproveita os tanques ja alocados no snapshot quando o numero de jogadores nao muda
+    if (static_cast<int>(snapshot.tanks.size()) != g_numPlayers) {
+        snapshot.tanks.clear();
+        for (int p = 0; p < g_numPlayers; p++) snapshot.tanks.push_back(*g_tanks[p]);
+    } else {
+        for (int p = 0; p < g_numPlayers; p++) snapshot.tanks[p] = *g_tanks[p];
+    }
+    snapshot.targets = g_targets;
+    snapshot.projectiles = g_projectiles;
+    snapshot.explosions = g_explosions;
+    snapshot.powerUp = g_powerUp;
+    snapshot.laser = PowerUp::laser;
+
+    // so copia a pista quando ela foi editada
+    if (!g_publishedTrack || g_publishedTrackRevision != g_track->revision) {
+        g_publishedTrack = std::make_shared<const BSplineTrack>(*g_track);
+        g_publishedTrackRevision = g_track->revision;
+    }
+    snapshot.track = g_publishedTrack;
+
+    snapshot.storedPowerUp = g_storedPowerUp;
+    snapshot.playerScore = g_playerScore;
+    snapshot.gameLevel = g_gameLevel;
+    snapshot.destroyedTargets = g_destroyedTargets;
+    snapshot.editorMode = g_editorMode;
+    snapshot.camera = g_editorMode ? g_editorCamera : g_gameCamera;
+    snapshot.stepTime = FixedTimestep::Clock::now();
+    snapshot.stepSeconds = g_clock.stepSeconds;
+
+    g_snapshots.Publish();
+}
+
+// aplica os ajustes do nivel de qualidade atual que nao dependem do quadro
+void ApplyQualityLevel()
+{
+    const QualityLevel& quality = g_qualityGovernor.GetLevel();
+    // circulos no shader nao tem lados, entao o detalhe so vale para os poligonos
+    if (g_qualityGovernor.circleDetailUsed) {
+        CV::circleDetail(quality.circleDetail);
+    }
+    CV::multisample(quality.multisample);
+    ExplosionManager::EmissionScale().store(quality.particleScale);
+}
+
+// desenha o mundo visto por uma camera, testando cada objeto contra a area visivel
+void RenderWorld(GameSnapshot& snapshot, float alpha, const Camera& view, const QualityLevel& quality)
+{
+    view.Apply();
+
+    // renderiza o track (na GPU se possivel; senao a tesselacao em cache da CPU com culling por trecho).
+    // nos dois casos a geometria e a mesma para todas as cameras, nada e refeito por viewport
+    if (snapshot.track) {
+        if (g_trackShader.Render(*snapshot.track, quality.trackDetail)) {
+            if (snapshot.editorMode) snapshot.track->RenderControlPoints();
+        } else {
+            snapshot.track->Render(snapshot.editorMode, quality.trackDetail, &view);
         }
+    }
 
-        g_tanque->Render();
-    } else if (g_editorMode && g_tanque) {
-        // no editar, coloca so a posicao inicial que o tanque spawnaria
-        if (g_track) {
-            Vector2 pL = g_track->getPointOnCurve(0.0f, CurveSide::Left);
-            Vector2 pR = g_track->getPointOnCurve(0.0f, CurveSide::Right);
-            g_tanque->position = (pL + pR) * 0.5f;  
+    if (!snapshot.editorMode) {
+        // marcas no chao, por cima da pista e por baixo de tudo o resto
+        g_decals.Render(view);
 
-            Vector2 tangentL = g_track->getTangentOnCurve(0.0f, CurveSide::Left);
-            Vector2 tangentR = g_track->getTangentOnCurve(0.0f, CurveSide::Right);
-            Vector2 avgTangent = (tangentL + tangentR) * 0.5f;
+        // renderiza power ups
+        if (view.IsCircleVisible(snapshot.powerUp.position, snapshot.powerUp.radius * 1.2f)) {
+            snapshot.powerUp.Render();
+        }
 
-            if (avgTangent.lengthSq() > 0.001f) { 
-                avgTangent.normalize();
-                g_tanque->baseAngle = atan2(avgTangent.y, avgTangent.x);
-            } else {
-                g_tanque->baseAngle = 0.0f; 
-            }
-            g_tanque->topAngle = g_tanque->baseAngle; 
-            g_tanque->forwardVector.set(cos(g_tanque->baseAngle), sin(g_tanque->baseAngle));
+        // renderiza os inimigos (cada um testa se esta na tela)
+        snapshot.targets.Render(alpha, &view);
+
+        // renderiza o efeito do laser (deve ser renderizado após os inimigos, mas antes do tanque)
+        PowerUp::RenderLaserEffect(snapshot.laser);
+
+        // todos os projeteis e as explosoes, por baixo dos tanques
+        snapshot.projectiles.Render(alpha, &view);
+        snapshot.explosions.Render(alpha, &view);
+    }
+
+    for (auto& tank : snapshot.tanks) {
+        tank.Render(alpha);
+    }
+}
+
+// desenha um snapshot do jogo, interpolando entre os dois ultimos passos (alpha de 0 a 1)
+void RenderGame(GameSnapshot& snapshot, float alpha)
+{
+    const QualityLevel& quality = g_qualityGovernor.GetLevel();
+
+    // a textura do minimapa so e refeita quando a pista muda (antes de limpar a tela)
+    if (!snapshot.editorMode && snapshot.track) {
+        g_minimap.Update(*snapshot.track, quality.trackDetail, screenWidth, screenHeight);
+        g_decals.Update(screenWidth, screenHeight);
+    }
+
+    CV::clear(0.25f, 0.25f, 0.3f);
+    if (snapshot.tanks.empty()) return;
+
+    // o mundo pode ser desenhado em resolucao reduzida; o editor sempre usa resolucao cheia
+    CV::beginScaledRender(snapshot.editorMode ? 1.0f : quality.renderScale);
+
+    // no jogo cada jogador tem sua parte da tela, com a camera seguindo a posicao interpolada do seu tanque
+    int numViews = snapshot.editorMode ? 1 : static_cast<int>(snapshot.tanks.size());
+    Camera views[MAX_PLAYERS];
+    int viewX[MAX_PLAYERS], viewY[MAX_PLAYERS];
+    for (int p = 0; p < numViews; p++) {
+        int vw, vh;
+        GetPlayerViewport(p, numViews, screenWidth, screenHeight, viewX[p], viewY[p], vw, vh);
+        views[p] = snapshot.camera;
+        views[p].SetViewport(static_cast<float>(vw), static_cast<float>(vh));
+        if (!snapshot.editorMode) {
+            views[p].center = snapshot.tanks[p].GetRenderPosition(alpha);
         }
-        g_tanque->Render();
+
+        CV::viewport(viewX[p], viewY[p], vw, vh);
+        RenderWorld(snapshot, alpha, views[p], quality);
     }
+    CV::viewport(0, 0, screenWidth, screenHeight);
+
+    CV::endScaledRender();
 
     // textos na tela
+    CV::translate(0, 0);
+    if (snapshot.editorMode && snapshot.track) {
+        snapshot.track->RenderEditorHelp();
+    }
+
     char scoreText[100]; 
     char powerText[100];
-    if(!g_editorMode){
-        CV::translate(0, 0);
-        sprintf(scoreText, "Score: %d | Level: %d | Targets: %d/%d", g_playerScore, g_gameLevel, g_destroyedTargets, NUM_TARGETS);
+    if(!snapshot.editorMode){
+        // divisoria entre as telas dos jogadores
+        CV::color(1.0f, 1.0f, 1.0f);
+        for (int p = 1; p < numViews; p++) {
+            CV::line(static_cast<float>(viewX[p]), 0.0f, static_cast<float>(viewX[p]), static_cast<float>(screenHeight));
+        }
+
+        sprintf(scoreText, "Score: %d | Level: %d | Targets: %d/%d", snapshot.playerScore, snapshot.gameLevel, snapshot.destroyedTargets, NUM_TARGETS);
         CV::color(1.0f, 1.0f, 1.0f);
         CV::text(10, 40, scoreText);
 
-        sprintf(powerText, "PowerUp: %s", PowerUp::GetTypeName(g_storedPowerUp));
+        sprintf(powerText, "PowerUp: %s", PowerUp::GetTypeName(snapshot.storedPowerUp));
         CV::text(10, 60, powerText);
 
         CV::text(10, 20, "Modo de Jogo | A/D = Girar | 'E' = Editor | 'M1' = Tiro | 'M2' = Poder");
+        CV::text(10, 80, "'2' = Tela dividida | Jogador 2: J/L = Girar | K = Tiro | I = Poder | 'C' = Foto | 'V' = Video");
 
-        // checa game over
-        if (g_tanque->health <= 0) {
-            CV::color(1.0f, 0.0f, 0.0f);
-            char gameOverText[100];
-            sprintf(gameOverText, "GAME OVER! Final Score: %d - Pressione 'E' para reiniciar!", g_playerScore);
-            CV::text(screenWidth/2 - 180, screenHeight/2, gameOverText);
+        g_minimap.Render(snapshot, alpha, views, numViews, screenWidth, screenHeight);
+
+        // checa game over (na tela de cada jogador)
+        for (int p = 0; p < numViews; p++) {
+            if (snapshot.tanks[p].health <= 0) {
+                CV::color(1.0f, 0.0f, 0.0f);
+                char gameOverText[100];
+                sprintf(gameOverText, "GAME OVER! Final Score: %d - Pressione 'E' para reiniciar!", snapshot.playerScore);
+                CV::text(viewX[p] + views[p].viewportWidth/2 - 180, screenHeight/2, gameOverText);
+            }
         }
    }
+}
+
+//funcao chamada continuamente. Deve-se controlar o que desenhar por meio de variaveis globais
+//Todos os comandos para desenho na canvas devem ser chamados dentro da render().
+//Deve-se manter essa funo com poucas linhas de codigo
+void render()
+{
+    // avisa a simulacao quando a janela muda de tamanho
+    static int lastWidth = 0, lastHeight = 0;
+    if (screenWidth != lastWidth || screenHeight != lastHeight) {
+        InputEvent event = {};
+        event.type = InputEventType::Resize;
+        event.x = screenWidth;
+        event.y = screenHeight;
+        if (g_inputQueue.Push(event)) {
+            lastWidth = screenWidth;
+            lastHeight = screenHeight;
+        }
+    }
+
+    // le o snapshot mais recente sem travar a simulacao
+    GameSnapshot& snapshot = g_snapshots.Read();
+
+    // interpola pelo tempo que passou desde o ultimo passo publicado
+    float alpha = 1.0f;
+    if (!snapshot.editorMode) {
+        float sinceStep = std::chrono::duration<float>(FixedTimestep::Clock::now() - snapshot.stepTime).count();
+        alpha = std::min(1.0f, std::max(0.0f, sinceStep / snapshot.stepSeconds));
+    }
+
+    // jogo e captura em andamento redesenham sem parar; o editor so quando a simulacao publica uma mudanca.
+    // a captura so termina quando o anel de leituras esvazia, o que leva alguns quadros
+    CV::continuousRedraw(!snapshot.editorMode || g_capture.HasPendingWork());
 
-   Sleep(10); 
+    RenderGame(snapshot, alpha);
+
+    // le o quadro pronto para a captura; o aviso de gravacao e desenhado depois para nao aparecer no video
+    g_capture.CaptureFrame(screenWidth, screenHeight);
+    if (g_capture.IsRecording()) {
+        char recText[64];
+        sprintf(recText, "REC (descartados: %d)", g_capture.GetDroppedFrames());
+        CV::translate(0, 0);
+        CV::color(1.0f, 0.0f, 0.0f);
+        CV::text(10, screenHeight - 20, recText);
+    }
+
+    // mede o intervalo entre quadros e deixa o controle de qualidade reagir.
+    // sob demanda ou sem foco o intervalo nao reflete o custo do quadro, entao nao conta
+    static FixedTimestep::Clock::time_point lastFrame = FixedTimestep::Clock::now();
+    static bool lastFrameContinuous = false;
+    FixedTimestep::Clock::time_point now = FixedTimestep::Clock::now();
+    float frameMs = std::chrono::duration<float, std::milli>(now - lastFrame).count();
+    lastFrame = now;
+    bool continuous = CV::isRedrawingContinuously();
+    g_qualityGovernor.circleDetailUsed = !CV::sdfCircles();
+    if (continuous && lastFrameContinuous && g_qualityGovernor.AddFrame(frameMs)) {
+        ApplyQualityLevel();
+    }
+    lastFrameContinuous = continuous;
 }
 
-//funcao chamada toda vez que uma tecla for pressionada.
-void keyboard(int key)
+// trata uma tecla pressionada (thread de simulacao)
+void HandleKeyDown(int key)
 {
 
     switch(key)
     {
-        case 27: // esc sai do jogo
-    	    exit(0);
-    	break;
-
         case 'a':
         case 'A':
-            if (!g_editorMode) keyA_down = true;
+            if (!g_editorMode) g_playerInput[0].rotateLeft = true;
             else if(g_track){
-                g_track->addControlPoint(Vector2(mouseX, mouseY));
+                g_track->addControlPoint(g_editorCamera.ScreenToWorld(static_cast<float>(mouseX), static_cast<float>(mouseY)));
             }
         break;
         case 'd':
         case 'D':
-            if (!g_editorMode) keyD_down = true;
+            if (!g_editorMode) g_playerInput[0].rotateRight = true;
             else if (g_track){
                 g_track->removeControlPoint();
             }
@@ -561,15 +1026,47 @@ void keyboard(int key)
                     g_track->deselectControlPoint();
                 }
               
-                resetTankToTrackStart(g_tanque, g_track);
+                ResetPlayersToTrackStart(g_track);
               
-                ResetGameState(g_tanque, g_track);
+                ResetGameState(g_track);
+
+                // nao simula o tempo que passou no editor
+                g_clock.Reset();
             } else {
-                keyA_down = false;
-                keyD_down = false;
+                for (int p = 0; p < MAX_PLAYERS; p++) g_playerInput[p] = PlayerInput();
             }
         break;
 
+        // liga/desliga o segundo jogador (tela dividida); os dois recomecam no inicio da pista
+        case '2':
+            if (!g_editorMode && g_track) {
+                g_numPlayers = g_numPlayers == 1 ? MAX_PLAYERS : 1;
+                ResetPlayersToTrackStart(g_track);
+                for (int p = 0; p < g_numPlayers; p++) {
+                    g_tanks[p]->health = g_tanks[p]->maxHealth;
+                }
+                g_projectiles.Clear(ProjectileTeam::Player);
+            }
+        break;
+
+        // controles do segundo jogador
+        case 'j':
+        case 'J':
+            if (!g_editorMode) g_playerInput[1].rotateLeft = true;
+        break;
+        case 'l':
+        case 'L':
+            if (!g_editorMode) g_playerInput[1].rotateRight = true;
+        break;
+        case 'k':
+        case 'K':
+            if (!g_editorMode && g_numPlayers > 1) g_tanks[1]->FireProjectile(g_projectiles, 1);
+        break;
+        case 'i':
+        case 'I':
+            if (!g_editorMode && g_numPlayers > 1) UsePowerUp(g_tanks[1], g_targets);
+        break;
+
         case 's': 
         case 'S':
             if (g_editorMode && g_track) {
@@ -577,76 +1074,268 @@ void keyboard(int key)
             }
         break;
 
+        // setas movem a camera do editor (teclas especiais chegam somadas de 100)
+        case GLUT_KEY_LEFT + 100:
+            if (g_editorMode) g_editorCamera.Pan(CAMERA_KEY_PAN, 0);
+        break;
+        case GLUT_KEY_RIGHT + 100:
+            if (g_editorMode) g_editorCamera.Pan(-CAMERA_KEY_PAN, 0);
+        break;
+        case GLUT_KEY_UP + 100:
+            if (g_editorMode) g_editorCamera.Pan(0, CAMERA_KEY_PAN);
+        break;
+        case GLUT_KEY_DOWN + 100:
+            if (g_editorMode) g_editorCamera.Pan(0, -CAMERA_KEY_PAN);
+        break;
+
 
 
    }
 }
 
-//funcao chamada toda vez que uma tecla for liberada
-void keyboardUp(int key)
+// trata uma tecla liberada (thread de simulacao)
+void HandleKeyUp(int key)
 {
     switch(key)
     {
         case 'a':
         case 'A':
-            keyA_down = false;
+            g_playerInput[0].rotateLeft = false;
             break;
         case 'd':
         case 'D':
-            keyD_down = false;
+            g_playerInput[0].rotateRight = false;
+            break;
+        case 'j':
+        case 'J':
+            g_playerInput[1].rotateLeft = false;
+            break;
+        case 'l':
+        case 'L':
+            g_playerInput[1].rotateRight = false;
             break;
     }
 }
 
-//funcao para tratamento de mouse: cliques, movimentos e arrastos
-void mouse(int button, int state, int wheel, int direction, int x, int y)
+// trata o mouse: cliques, movimentos e arrastos (thread de simulacao)
+void HandleMouse(int button, int state, int wheel, int direction, int x, int y)
 {
     mouseX = x; //guarda as coordenadas do mouse para utilizar em outras funcs
     mouseY = y;
 
+    // o mouse sempre e convertido para o mundo pela camera do modo atual
+    Camera& camera = g_editorMode ? g_editorCamera : g_gameCamera;
+    Vector2 world = camera.ScreenToWorld(static_cast<float>(x), static_cast<float>(y));
+
+    // roda do mouse: zoom (no editor, em torno do cursor)
+    if (wheel != -2) {
+        float factor = direction > 0 ? CAMERA_ZOOM_STEP : 1.0f / CAMERA_ZOOM_STEP;
+        if (g_editorMode) {
+            camera.ZoomAt(factor, static_cast<float>(x), static_cast<float>(y));
+        } else {
+            camera.ZoomAt(factor, camera.viewportWidth / 2.0f, camera.viewportHeight / 2.0f);
+        }
+        return;
+    }
+
     if (g_editorMode && g_track) { // verifica os arratos dos pontos de controle
         if (button == 0) {
             if (state == 0) { 
                 g_mousePressed = true;
-                if (!g_track->selectControlPoint(static_cast<float>(x), static_cast<float>(y))) {
+                if (!g_track->selectControlPoint(world.x, world.y, 1.0f / camera.zoom)) {
                     
                 }
             } else { 
                 g_mousePressed = false;
             }
         }
+        else if (button == 2) { // botao direito arrasta a camera
+            g_cameraPanning = (state == 0);
+            g_panLastX = x;
+            g_panLastY = y;
+        }
+        else if (g_cameraPanning) {
+            camera.Pan(static_cast<float>(x - g_panLastX), static_cast<float>(y - g_panLastY));
+            g_panLastX = x;
+            g_panLastY = y;
+        }
     }
-    else if (!g_editorMode && g_tanque) {
+    else if (!g_editorMode && g_tanks[0]) {
         if (button == 0 && state == 0) { // TIRO
-            bool fired = g_tanque->FireProjectile();
+            g_tanks[0]->FireProjectile(g_projectiles, 0);
         }
         else if (button == 2 && state == 0) { // PODER
-            UsePowerUp(g_tanque, g_targets);
+            UsePowerUp(g_tanks[0], g_targets);
         }
     }
 
     if (g_editorMode && g_track && g_mousePressed && g_track->selectedPointIndex != -1) { // arrasto do ponto de controle
-        g_track->moveSelectedControlPoint(static_cast<float>(x), static_cast<float>(y));
+        g_track->moveSelectedControlPoint(world.x, world.y);
+    }
+
+}
+
+// consome todos os eventos de entrada pendentes (thread de simulacao); retorna quantos foram tratados
+int ProcessInput()
+{
+    int processed = 0;
+    InputEvent event;
+    while (g_inputQueue.Pop(event)) {
+        processed++;
+        switch (event.type) {
+            case InputEventType::KeyDown:
+                HandleKeyDown(event.key);
+                break;
+            case InputEventType::KeyUp:
+                HandleKeyUp(event.key);
+                break;
+            case InputEventType::Mouse:
+                HandleMouse(event.button, event.state, event.wheel, event.direction, event.x, event.y);
+                break;
+            case InputEventType::Resize:
+                g_simScreenWidth = event.x;
+                g_simScreenHeight = event.y;
+                g_gameCamera.SetViewport(static_cast<float>(event.x), static_cast<float>(event.y));
+                g_editorCamera.SetViewport(static_cast<float>(event.x), static_cast<float>(event.y));
+                break;
+        }
+    }
+    return processed;
+}
+
+// laco da thread de simulacao: entrada, passos fixos e publicacao do snapshot
+void SimulationLoop()
+{
+    // no editor nada muda sem entrada, entao so publica (e pede redesenho) quando chega um evento
+    bool editorPublished = false;
+
+    while (g_simulationRunning.load()) {
+        int events = ProcessInput();
+
+        // roda quantos passos fixos couberem no tempo real decorrido, independente do fps
+        int steps = g_clock.Advance();
+
+        if (!g_editorMode) {
+            for (int i = 0; i < steps; i++) {
+                UpdateGame();
+            }
+            editorPublished = false;
+            PublishSnapshot();
+            CV::requestRedraw();
+        } else if (events > 0 || !editorPublished) {
+            UpdateEditorPreview();
+            editorPublished = true;
+            PublishSnapshot();
+            CV::requestRedraw();
+        }
+
+        // dorme ate o proximo passo
+        float waitSeconds = g_clock.SecondsUntilNextStep();
+        if (waitSeconds > 0.0f) {
+            std::this_thread::sleep_for(std::chrono::duration<float>(waitSeconds));
+        }
+    }
+}
+
+// termina de escrever as capturas pendentes antes de sair do programa
+void StopCapture()
+{
+    g_capture.Stop();
+}
+
+// encerra a thread de simulacao antes de sair do programa
+void StopSimulation()
+{
+    g_simulationRunning.store(false);
+    if (g_simulationThread.joinable()) {
+        g_simulationThread.join();
+    }
+    g_flowField.Stop(); // thread de calculo do campo das estrelas
+}
+
+//funcao chamada toda vez que uma tecla for pressionada.
+void keyboard(int key)
+{
+    if (key == 27) { // esc sai do jogo (StopSimulation roda via atexit)
+        exit(0);
+    }
+
+    // captura e tratada aqui mesmo, pois pertence a thread de renderizacao
+    // no editor o redesenho e sob demanda, entao pede um quadro para a captura comecar
+    if (key == 'c' || key == 'C') {
+        g_capture.RequestScreenshot();
+        CV::requestRedraw();
+        return;
+    }
+    if (key == 'v' || key == 'V') {
+        g_capture.ToggleRecording();
+        CV::requestRedraw();
+        return;
     }
 
+    InputEvent event = {};
+    event.type = InputEventType::KeyDown;
+    event.key = key;
+    g_inputQueue.Push(event);
+}
+
+//funcao chamada toda vez que uma tecla for liberada
+void keyboardUp(int key)
+{
+    InputEvent event = {};
+    event.type = InputEventType::KeyUp;
+    event.key = key;
+    g_inputQueue.Push(event);
+}
+
+//funcao para tratamento de mouse: cliques, movimentos e arrastos
+void mouse(int button, int state, int wheel, int direction, int x, int y)
+{
+    InputEvent event;
+    event.type = InputEventType::Mouse;
+    event.key = 0;
+    event.button = button;
+    event.state = state;
+    event.wheel = wheel;
+    event.direction = direction;
+    event.x = x;
+    event.y = y;
+    g_inputQueue.Push(event);
 }
 
 int main(void)
 {
     srand(static_cast<unsigned int>(time(NULL))); // randoms
 
-    g_tanque = new Tanque(screenWidth / 4.0f, screenHeight / 2.0f, 0.7f, 0.02f);
+    for (int p = 0; p < MAX_PLAYERS; p++) {
+        g_tanks[p] = new Tanque(screenWidth / 4.0f, screenHeight / 2.0f, 0.7f, 0.02f);
+    }
+    // segundo jogador em laranja
+    g_tanks[1]->bodyColorR = 0.6f;
+    g_tanks[1]->bodyColorG = 0.4f;
+    g_tanks[1]->bodyColorB = 0.1f;
     g_track = new BSplineTrack(true);
 
     // inicializa o tanque, os targets e um power-up
-    resetTankToTrackStart(g_tanque, g_track);
+    ResetPlayersToTrackStart(g_track);
 
     InitializeTargets(g_track);
+    ApplyCommands();
 
     if (!g_powerUp.active) {
         SpawnPowerUp(g_track);
     }
 
+    // primeiro snapshot para a renderizacao ter o que desenhar
+    PublishSnapshot();
+
     CV::init(&screenWidth, &screenHeight, "Gabriel 'Theft' Baggio VI - Tanque Edition");
+
+    // a partir daqui o estado do jogo pertence a thread de simulacao
+    g_simulationRunning.store(true);
+    g_simulationThread = std::thread(SimulationLoop);
+    atexit(StopSimulation); // a GLUT chama exit() ao fechar a janela
+    atexit(StopCapture);
+
     CV::run();
 }